@@ -2,7 +2,7 @@
 #define DFS_H
 
 #include <vector>
-#include <fstream>
+#include "pathfinder.h"
 
 struct Cell {
     int row;
@@ -11,36 +11,26 @@ struct Cell {
 };
 
 /**
- * @brief Performs a Depth-First Search (DFS) on a maze to find a path from the start position to the goal position.
- * 
- * @param maze A reference to a 2D vector representing the maze, where each cell contains a character.
- * @param row The current row position in the maze.
- * @param col The current column position in the maze.
- * @param path A pointer to a Cell object that stores the path from the start to the goal.
- * @param goalRow The row position of the goal in the maze.
- * @param goalCol The column position of the goal in the maze.
- * @return true If a path from the start to the goal is found.
- * @return false If no path from the start to the goal is found.
- */
-bool dfs(std::vector<std::vector<char>>& maze, int row, int col, Cell*& path, int goalRow, int goalCol);
-
-/**
- * @brief Reads a maze from a file and performs a depth-first search (DFS) to find a path from the start to the goal.
+ * @brief Finds the shortest path from the entrance to the exit of a maze grid in memory.
  *
+ * This is a thin wrapper around solveMaze(). The path is returned as a linked list
+ * whose nodes live in one contiguous array, so it is allocated with a single `new`.
+ *
+ * @param grid The maze, row-major with width * height cells.
+ * @param width The number of columns of the maze.
+ * @param height The number of rows of the maze.
+ * @param wall The cell value that blocks movement.
+ * @param algorithm The search strategy to use.
  * @return A pointer to the first Cell in the linked list representing the path, or nullptr if no path is found.
  */
-Cell* findPath();
+Cell* findPath(const unsigned char *grid, int width, int height, unsigned char wall,
+               PathAlgorithm algorithm = PathAlgorithm::BFS);
 
 /**
- * @brief Deletes a linked list of Cells representing a path in the maze.
- *
- * This function iterates over a linked list of Cells, deleting each Cell as it goes.
- * It uses a while loop to traverse the list. Inside the loop, it saves the pointer to the next Cell,
- * deletes the current Cell, and then moves the path pointer to the next Cell.
- * The loop continues until it has deleted all Cells, i.e., until the path pointer is nullptr.
+ * @brief Frees a path returned by findPath().
  *
  * @param path A pointer to the first Cell in the linked list representing the path.
  */
 void deletePath(Cell* path);
 
-#endif
\ No newline at end of file
+#endif
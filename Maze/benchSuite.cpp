@@ -0,0 +1,383 @@
+#include "benchSuite.h"
+#include "DFS.h"
+#include "mazeFile.h"
+#include "mazeGame.h"
+#include "minesweeper.h"
+#include "minewseepergen.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+#define BENCH_SEED 1340 // Seed of every maze and minefield in the suite, so that runs compare like for like
+#define BENCH_MIN_SIZE 15 // The smallest maze side length of the suite
+#define BENCH_BOARD_SIZE 1000 // Side length of the large minesweeper boards
+#define BENCH_BITBOARD_SIZE 4096 // Side length of the largest bit-packed minesweeper board
+
+BenchState::BenchState(const string &name, double itemsPerIteration, double minSeconds)
+    : name(name), itemsPerIteration(itemsPerIteration), minSeconds(minSeconds) {}
+
+double BenchState::wallNow() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+double BenchState::cpuNow() {
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+bool BenchState::keepRunning() {
+    if (!started) {
+        started = true;
+        resumeTiming();
+        wallBegin = wallStart;
+        return true;
+    }
+    iterations++;
+    if (paused) {
+        resumeTiming();
+    }
+    double now = wallNow();
+    double timed = wallTotal + (now - wallStart);
+    if (timed < minSeconds && iterations < BENCH_MAX_ITERATIONS && now - wallBegin < BENCH_MAX_WALL_SECONDS) {
+        return true;
+    }
+    pauseTiming();
+    return false;
+}
+
+void BenchState::pauseTiming() {
+    wallTotal += wallNow() - wallStart;
+    cpuTotal += cpuNow() - cpuStart;
+    paused = true;
+}
+
+void BenchState::resumeTiming() {
+    paused = false;
+    cpuStart = cpuNow();
+    wallStart = wallNow();
+}
+
+BenchResult BenchState::result() const {
+    long runs = iterations > 0 ? iterations : 1;
+    return {name, iterations, wallTotal / runs * 1e9, cpuTotal / runs * 1e9,
+            wallTotal > 0 ? itemsPerIteration * runs / wallTotal : 0};
+}
+
+/**
+ * @brief Reads the maze text file line by line, the way main() loaded saves before the binary format.
+ * @param path The text file to read
+ * @return The rows of the maze
+ */
+static vector<string> loadText(const string &path) {
+    ifstream file(path);
+    vector<string> mazemap;
+    string line;
+    while (getline(file, line)) {
+        mazemap.push_back(line);
+    }
+    return mazemap;
+}
+
+/**
+ * @brief Maps a binary save and copies its rows out, the way main() loads a saved game.
+ * @param path The binary file to read
+ * @return The rows of the maze
+ */
+static vector<string> loadBinary(const string &path) {
+    MappedMaze mapped(path);
+    vector<string> mazemap;
+    mazemap.reserve(mapped.height());
+    for (int y = 0; y < mapped.height(); y++) {
+        mazemap.emplace_back(mapped.row(y), mapped.width());
+    }
+    return mazemap;
+}
+
+/**
+ * @brief Runs the maze benchmarks for one side length.
+ *
+ * A reference maze is built step by step in the same order as the game. Each step is
+ * timed on a fresh copy of the maze as it was before that step, so that every iteration
+ * does the same work, and is then applied to the reference for the next step.
+ *
+ * @param size The side length of the maze.
+ * @param results Receives one entry per benchmark.
+ */
+static void benchmarkMazeSize(int size, vector<BenchResult> &results) {
+    const string suffix = "/" + to_string(size);
+    const double cells = static_cast<double>(size) * size;
+    volatile size_t sink = 0;
+
+    BenchState generate("generateMaze" + suffix, cells);
+    while (generate.keepRunning()) {
+        generate.pauseTiming();
+        Maze maze(size, size, BENCH_SEED);
+        generate.resumeTiming();
+        maze.generateMaze(maze.startX, maze.startY);
+        generate.pauseTiming();
+    }
+    results.push_back(generate.result());
+
+    Maze reference(size, size, BENCH_SEED);
+    reference.generateMaze(reference.startX, reference.startY);
+
+    BenchState pathfinding("findPath" + suffix, cells);
+    while (pathfinding.keepRunning()) {
+        Cell *path = findPath(reference.maze.data(), size, size, WALL);
+        pathfinding.pauseTiming();
+        sink = sink + (path != nullptr);
+        deletePath(path);
+    }
+    results.push_back(pathfinding.result());
+
+    vector<PathNode> path = reference.solve();
+    BenchState checkpoints("placeCheckpoints" + suffix, cells);
+    while (checkpoints.keepRunning()) {
+        checkpoints.pauseTiming();
+        Maze maze = reference;
+        checkpoints.resumeTiming();
+        maze.placeCheckpoints();
+        checkpoints.pauseTiming();
+    }
+    results.push_back(checkpoints.result());
+
+    reference.placeCheckpoints();
+    reference.markPath(path);
+    BenchState monsters("placeMonsters" + suffix, cells);
+    while (monsters.keepRunning()) {
+        monsters.pauseTiming();
+        Maze maze = reference;
+        monsters.resumeTiming();
+        maze.placeMonsters(0.5f);
+        monsters.pauseTiming();
+    }
+    results.push_back(monsters.result());
+
+    reference.placeMonsters(0.5f);
+    BenchState save("saveMaze" + suffix, cells);
+    while (save.keepRunning()) {
+        reference.saveMaze();
+    }
+    results.push_back(save.result());
+
+    BenchState binary("loadMazeBinary" + suffix, cells);
+    while (binary.keepRunning()) {
+        sink = sink + loadBinary(".gameConfig/maze.bin").size();
+    }
+    results.push_back(binary.result());
+
+    reference.exportText();
+    BenchState text("loadMazeText" + suffix, cells);
+    while (text.keepRunning()) {
+        sink = sink + loadText(".gameConfig/maze.txt").size();
+    }
+    results.push_back(text.result());
+}
+
+/**
+ * @brief Runs the minesweeper benchmarks for one board size.
+ *
+ * The board has the game's mine density and, as in the game, is generated around a
+ * first click, here in the centre. revealPos() is timed from the blank tile with
+ * the largest opening among a few spread over the board, and its rate counts the tiles one reveal
+ * uncovers. checkIfGameWin() is timed on a board with every safe tile revealed.
+ *
+ * @param size The side length of the board.
+ * @param results Receives one entry per benchmark.
+ */
+static void benchmarkMinesweeper(int size, vector<BenchResult> &results) {
+    const string suffix = "/" + to_string(size);
+    const double tiles = static_cast<double>(size) * size;
+    Board minefield(size, size);
+    FloodScratch scratch;
+    volatile bool sink = false;
+
+    mt19937_64 rng(BENCH_SEED);
+    BenchState generate("minefieldgen" + suffix, tiles);
+    while (generate.keepRunning()) {
+        minefieldgen(minefield, encounterMines(size), rng, size / 2, size / 2);
+    }
+    results.push_back(generate.result());
+
+    GameBoard gameBoard(minefield);
+    int bestRow = 0;
+    int bestCol = 0;
+    int bestRevealed = 0;
+    for (int probe = 0; probe < 16; probe++) {
+        int cell = static_cast<int>(minefield.size() * probe / 16);
+        while (cell < static_cast<int>(minefield.size()) && minefield.data()[cell] != ' ') {
+            cell++;
+        }
+        if (cell == static_cast<int>(minefield.size())) {
+            continue;
+        }
+        gameBoard = GameBoard(minefield);
+        int revealed = gameBoard.reveal(minefield, cell / size, cell % size, scratch);
+        if (revealed > bestRevealed) {
+            bestRevealed = revealed;
+            bestRow = cell / size;
+            bestCol = cell % size;
+        }
+    }
+
+    BenchState reveal("revealPos" + suffix, max(bestRevealed, 1));
+    while (reveal.keepRunning()) {
+        reveal.pauseTiming();
+        gameBoard = GameBoard(minefield);
+        reveal.resumeTiming();
+        sink = revealPos(minefield, gameBoard, bestRow, bestCol, scratch);
+    }
+    results.push_back(reveal.result());
+
+    for (int r = 0; r < size; r++) {
+        for (int c = 0; c < size; c++) {
+            if (minefield.at(r, c) != 'X') {
+                revealPos(minefield, gameBoard, r, c, scratch);
+            }
+        }
+    }
+    BenchState win("checkIfGameWin" + suffix, tiles);
+    while (win.keepRunning()) {
+        sink = checkIfGameWin(gameBoard);
+    }
+    results.push_back(win.result());
+    (void)sink;
+}
+
+/**
+ * @brief Runs the minesweeper benchmarks of the bit-packed board for one size.
+ *
+ * Same steps as benchmarkMinesweeper(), on a BitBoard: the minefield is generated around
+ * the centre, revealPos() is timed from the centre, which is always blank, and
+ * checkIfGameWin() on a cleared board.
+ *
+ * @param size The side length of the board.
+ * @param results Receives one entry per benchmark.
+ */
+static void benchmarkBitBoard(int size, vector<BenchResult> &results) {
+    const string suffix = "/" + to_string(size);
+    const double tiles = static_cast<double>(size) * size;
+    BitBoard board(size, size);
+    volatile bool sink = false;
+
+    mt19937_64 rng(BENCH_SEED);
+    BenchState generate("bitMinefieldgen" + suffix, tiles);
+    while (generate.keepRunning()) {
+        minefieldgen(board, encounterMines(size), rng, size / 2, size / 2);
+    }
+    results.push_back(generate.result());
+
+    int revealed = board.reveal(size / 2, size / 2);
+    BenchState reveal("bitRevealPos" + suffix, max(revealed, 1));
+    while (reveal.keepRunning()) {
+        reveal.pauseTiming();
+        board.cover();
+        reveal.resumeTiming();
+        sink = revealPos(board, size / 2, size / 2);
+    }
+    results.push_back(reveal.result());
+
+    for (int r = 0; r < size; r++) {
+        for (int c = 0; c < size; c++) {
+            if (!board.isMine(r, c)) {
+                revealPos(board, r, c);
+            }
+        }
+    }
+    BenchState win("bitCheckIfGameWin" + suffix, tiles);
+    while (win.keepRunning()) {
+        sink = checkIfGameWin(board);
+    }
+    results.push_back(win.result());
+    (void)sink;
+}
+
+/**
+ * @brief Writes the results in the layout of Google Benchmark's JSON reporter.
+ * @param results The results to write
+ * @param out The stream to write to
+ */
+static void writeJson(const vector<BenchResult> &results, ostream &out) {
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"mazeBench\",\n"
+        << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\",\n"
+#else
+        << "    \"library_build_type\": \"debug\",\n"
+#endif
+        << "    \"seed\": " << BENCH_SEED << ",\n"
+        << "    \"min_time\": " << BENCH_MIN_SECONDS << "\n"
+        << "  },\n"
+        << "  \"benchmarks\": [\n";
+    out << fixed << setprecision(1);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &result = results[i];
+        out << "    {\n"
+            << "      \"name\": \"" << result.name << "\",\n"
+            << "      \"run_name\": \"" << result.name << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << result.iterations << ",\n"
+            << "      \"real_time\": " << result.realNs << ",\n"
+            << "      \"cpu_time\": " << result.cpuNs << ",\n"
+            << "      \"time_unit\": \"ns\",\n"
+            << "      \"items_per_second\": " << result.itemsPerSecond << "\n"
+            << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n"
+        << "}" << endl;
+}
+
+int runBenchmarkSuite(int maxSize, ostream &out) {
+    char scratch[] = "/tmp/mazeBench.XXXXXX";
+    char *previous = getcwd(nullptr, 0);
+    if (mkdtemp(scratch) == nullptr || chdir(scratch) != 0 || mkdir(".gameConfig", 0755) != 0) {
+        cerr << "Unable to create a scratch directory for the benchmark files" << endl;
+        free(previous);
+        return 1;
+    }
+
+    vector<BenchResult> results;
+    for (int size = BENCH_MIN_SIZE; size <= maxSize; size = size * 2 + 1) {
+        cerr << "maze " << size << "x" << size << "..." << endl;
+        benchmarkMazeSize(size, results);
+    }
+    for (int size : {MSIZE, MSIZE_MAX, BENCH_BOARD_SIZE}) {
+        cerr << "minesweeper " << size << "x" << size << "..." << endl;
+        benchmarkMinesweeper(size, results);
+    }
+    for (int size : {BENCH_BOARD_SIZE, BENCH_BITBOARD_SIZE}) {
+        cerr << "minesweeper bitboard " << size << "x" << size << "..." << endl;
+        benchmarkBitBoard(size, results);
+    }
+
+    remove(".gameConfig/maze.bin");
+    remove(".gameConfig/maze.txt");
+    rmdir(".gameConfig");
+    if (previous == nullptr || chdir(previous) != 0) {
+        cerr << "Unable to return to the working directory" << endl;
+    }
+    free(previous);
+    rmdir(scratch);
+
+    writeJson(results, out);
+    return 0;
+}
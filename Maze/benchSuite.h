@@ -0,0 +1,97 @@
+#ifndef BENCHSUITE_H
+#define BENCHSUITE_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define BENCH_MIN_SECONDS 0.2 // Timed seconds each benchmark runs for before it reports
+#define BENCH_MAX_ITERATIONS 1000000 // Upper bound on the iterations of one benchmark
+#define BENCH_MAX_WALL_SECONDS 3.0 // Seconds, untimed setup included, after which a benchmark stops early
+
+/**
+ * @struct BenchResult
+ * @brief The averaged timings of one benchmark, one entry of the JSON report.
+ */
+struct BenchResult {
+    std::string name; /**< The function and the problem size, e.g. "generateMaze/255" */
+    long iterations; /**< The number of timed iterations */
+    double realNs; /**< The average wall-clock time per iteration in nanoseconds */
+    double cpuNs; /**< The average CPU time of the thread per iteration in nanoseconds */
+    double itemsPerSecond; /**< Cells (or tiles) processed per second of wall-clock time */
+};
+
+/**
+ * @class BenchState
+ * @brief Drives the timing loop of one benchmark, in the style of Google Benchmark.
+ *
+ * The body runs as `while (state.keepRunning()) { ... }` and repeats until it has been
+ * timed for at least the minimum time. Per-iteration setup that should not count, such
+ * as copying a fresh maze, goes between pauseTiming() and resumeTiming(). Since that
+ * setup can cost far more than the timed part, a benchmark also stops once it has run
+ * for BENCH_MAX_WALL_SECONDS in total.
+ */
+class BenchState {
+public:
+    /**
+     * @param name The name reported for the benchmark
+     * @param itemsPerIteration The number of cells or tiles one iteration processes
+     * @param minSeconds The timed seconds to run for
+     */
+    BenchState(const std::string &name, double itemsPerIteration, double minSeconds = BENCH_MIN_SECONDS);
+
+    /**
+     * @brief Starts the next iteration.
+     * @return True while more iterations are needed, false once the benchmark is done
+     */
+    bool keepRunning();
+
+    /**
+     * @brief Stops the clocks until resumeTiming().
+     */
+    void pauseTiming();
+
+    /**
+     * @brief Restarts the clocks stopped by pauseTiming().
+     */
+    void resumeTiming();
+
+    /**
+     * @brief Returns the averaged timings; only meaningful once keepRunning() returned false.
+     * @return The result for the report
+     */
+    BenchResult result() const;
+
+private:
+    static double wallNow();
+    static double cpuNow();
+
+    std::string name; /**< The name reported for the benchmark */
+    double itemsPerIteration; /**< The work of one iteration */
+    double minSeconds; /**< The timed seconds to run for */
+    long iterations = 0; /**< The iterations completed so far */
+    bool started = false; /**< True once the first iteration has begun */
+    bool paused = false; /**< True between pauseTiming() and resumeTiming() */
+    double wallBegin = 0; /**< Wall clock at the first iteration */
+    double wallStart = 0; /**< Wall clock at the last (re)start */
+    double cpuStart = 0; /**< Thread CPU clock at the last (re)start */
+    double wallTotal = 0; /**< Timed wall-clock seconds so far */
+    double cpuTotal = 0; /**< Timed CPU seconds so far */
+};
+
+/**
+ * @brief Runs every maze and minesweeper benchmark and writes the results as JSON.
+ *
+ * The maze benchmarks run for side lengths 15, 31, 63, ... up to maxSize, the minesweeper
+ * ones for the smallest and largest encounter boards and a 1000 x 1000 board, and the
+ * bit-packed board for 1000 x 1000 and 4096 x 4096. The report
+ * follows the layout of Google Benchmark's --benchmark_format=json, so existing tools
+ * for comparing two runs can read it. Progress goes to stderr.
+ *
+ * @param maxSize The largest maze side length to measure
+ * @param out The stream that receives the JSON report
+ * @return 0 on success, 1 if the scratch directory could not be created
+ */
+int runBenchmarkSuite(int maxSize, std::ostream &out);
+
+#endif
@@ -0,0 +1,793 @@
+#include "mazeGame.h"
+#include "pathfinder.h"
+#include "mazeFile.h"
+#include "gameSimulation.h"
+#include "monsterSwarm.h"
+#include "benchSuite.h"
+#include "minesweeper.h"
+#include "solver.h"
+#include "noguess.h"
+#include "minefieldPool.h"
+#include "threadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+#define SOLVE_BUDGET_MS 600 // Longest a release-build solve of a 4095 x 4095 maze may take, per algorithm
+
+/**
+ * @brief Times maze generation and reports the throughput.
+ *
+ * A size x size maze is generated `runs` times from the usual starting point and the
+ * average time per maze is printed together with the number of cells carved per second.
+ *
+ * @param size The side length of the maze.
+ * @param runs The number of mazes to generate.
+ */
+void benchmarkGeneration(int size, int runs) {
+    double totalSeconds = 0;
+    for (int i = 0; i < runs; i++) {
+        Maze maze(size, size);
+        auto begin = chrono::steady_clock::now();
+        maze.generateMaze(maze.startX, maze.startY);
+        auto end = chrono::steady_clock::now();
+        totalSeconds += chrono::duration<double>(end - begin).count();
+    }
+    double cells = static_cast<double>(size) * size * runs;
+    cout << "generate " << size << "x" << size << ": "
+         << totalSeconds / runs * 1000 << " ms/maze, "
+         << cells / totalSeconds << " cells/s" << endl;
+}
+
+/**
+ * @brief Times the pathfinding engine on a generated maze.
+ *
+ * One size x size maze is generated, then solved `runs` times from the entrance
+ * to the exit with BFS, A* and the corridor graph. The time to build the graph is
+ * printed separately; generateMaze() already pays it once per maze.
+ *
+ * In a release build every algorithm must stay within SOLVE_BUDGET_MS scaled by the
+ * number of cells, and at least 1 ms, or the solve is reported as over budget.
+ *
+ * @param size The side length of the maze.
+ * @param runs The number of solves per algorithm.
+ * @return The number of algorithms over budget.
+ */
+int benchmarkSolver(int size, int runs) {
+    Maze maze(size, size);
+    maze.generateMaze(maze.startX, maze.startY);
+    const PathAlgorithm algorithms[] = {PathAlgorithm::BFS, PathAlgorithm::AStar, PathAlgorithm::Corridor};
+    const char *names[] = {"bfs", "astar", "corridor"};
+    double budgetMs = max(1.0, SOLVE_BUDGET_MS * (static_cast<double>(size) * size) / (4095.0 * 4095.0));
+    int overBudget = 0;
+    for (int a = 0; a < 3; a++) {
+        size_t length = 0;
+        auto begin = chrono::steady_clock::now();
+        for (int i = 0; i < runs; i++) {
+            length = maze.solve(algorithms[a]).size();
+        }
+        auto end = chrono::steady_clock::now();
+        double seconds = chrono::duration<double>(end - begin).count();
+        double ms = seconds / runs * 1000;
+        cout << "solve " << names[a] << " " << size << "x" << size << ": " << ms << " ms/solve, path length "
+             << length << endl;
+#ifdef NDEBUG
+        if (ms > budgetMs) {
+            cout << "solve " << names[a] << " " << size << "x" << size << ": over the budget of " << budgetMs
+                 << " ms" << endl;
+            overBudget++;
+        }
+#endif
+    }
+
+    auto begin = chrono::steady_clock::now();
+    CorridorGraph graph(maze.maze.data(), size, size, WALL);
+    auto end = chrono::steady_clock::now();
+    cout << "corridor graph " << size << "x" << size << ": " << chrono::duration<double, milli>(end - begin).count()
+         << " ms to build, " << graph.nodeCount() << " nodes, " << graph.edgeCount() << " edges, "
+         << graph.deadEnds().size() << " dead ends" << endl;
+    return overBudget;
+}
+
+/**
+ * @brief Times monster placement for a series of maze sizes.
+ *
+ * Starting from 55, the side length is doubled (and kept odd) up to maxSize.
+ * For each size a maze is generated, solved and given checkpoints, then the
+ * placement pass is timed on its own. The time per cell should stay flat as
+ * the maze grows, since the path check is a mask lookup.
+ *
+ * @param maxSize The largest side length to measure.
+ * @param runs The number of placements per size.
+ */
+void benchmarkPlacement(int maxSize, int runs) {
+    for (int size = 55; size <= maxSize; size = size * 2 + 1) {
+        double totalSeconds = 0;
+        for (int i = 0; i < runs; i++) {
+            Maze maze(size, size);
+            maze.generateMaze(maze.startX, maze.startY);
+            maze.markPath(maze.solve());
+            maze.placeCheckpoints();
+            auto begin = chrono::steady_clock::now();
+            maze.placeMonsters(0.5f);
+            auto end = chrono::steady_clock::now();
+            totalSeconds += chrono::duration<double>(end - begin).count();
+        }
+        double cells = static_cast<double>(size) * size;
+        cout << "place " << size << "x" << size << ": "
+             << totalSeconds / runs * 1000 << " ms/placement, "
+             << totalSeconds / runs / cells * 1e9 << " ns/cell" << endl;
+    }
+}
+
+/**
+ * @brief Times loading a saved maze in the binary and text formats.
+ *
+ * One size x size maze is generated and saved in both formats in the current
+ * directory. Each load produces the same rows the game works with: the binary
+ * file is mapped with MappedMaze and its rows are copied out, while the text file
+ * is read line by line. The temporary files are removed afterwards.
+ *
+ * @param size The side length of the maze.
+ * @param runs The number of loads per format.
+ */
+void benchmarkLoad(int size, int runs) {
+    const string binaryPath = "mazeBench.bin";
+    const string textPath = "mazeBench.txt";
+    {
+        Maze maze(size, size);
+        maze.generateMaze(maze.startX, maze.startY);
+        maze.placeCheckpoints();
+        maze.placeMonsters(0.5f);
+        maze.saveMaze(binaryPath);
+        maze.exportText(textPath);
+    }
+
+    size_t rows = 0;
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        MappedMaze mapped(binaryPath);
+        vector<string> mazemap;
+        mazemap.reserve(mapped.height());
+        for (int y = 0; y < mapped.height(); y++) {
+            mazemap.emplace_back(mapped.row(y), mapped.width());
+        }
+        rows = mazemap.size();
+    }
+    auto end = chrono::steady_clock::now();
+    cout << "load binary " << size << "x" << size << ": "
+         << chrono::duration<double, milli>(end - begin).count() / runs << " ms/load (" << rows << " rows)" << endl;
+
+    begin = chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        ifstream file(textPath);
+        vector<string> mazemap;
+        string line;
+        while (getline(file, line)) {
+            mazemap.push_back(line);
+        }
+        rows = mazemap.size();
+    }
+    end = chrono::steady_clock::now();
+    cout << "load text " << size << "x" << size << ": "
+         << chrono::duration<double, milli>(end - begin).count() / runs << " ms/load (" << rows << " rows)" << endl;
+
+    remove(binaryPath.c_str());
+    remove(textPath.c_str());
+}
+
+/**
+ * @brief Drives a GameSimulation from this thread the way the game UI does.
+ *
+ * Monsters tick every millisecond while `runs` x 1000 random moves are posted and every
+ * published snapshot is taken. Encounters are answered with a random minesweeper result,
+ * and the player has enough HP never to lose. Built with -fsanitize=thread (`make tsan`)
+ * this exercises every path between the two threads.
+ *
+ * @param size The side length of the maze.
+ * @param runs The number of moves to post, in thousands.
+ */
+void benchmarkSimulation(int size, int runs) {
+    Maze maze(size, size);
+    maze.generateMaze(maze.startX, maze.startY);
+    maze.placeCheckpoints();
+    maze.markPath(maze.solve());
+    maze.placeMonsters(0.5f);
+    vector<string> mazemap = maze.toRows();
+    vector<pair<int, int>> monsterPositions;
+    vector<pair<int, int>> checkpointPositions;
+    for (const PathNode &monster : maze.monsters) {
+        mazemap[monster.row][monster.col] = ' ';
+        monsterPositions.emplace_back(monster.row, monster.col);
+    }
+    for (const PathNode &checkpoint : maze.checkpoints) {
+        checkpointPositions.emplace_back(checkpoint.row, checkpoint.col);
+    }
+
+    GameSimulation sim(mazemap, maze.corridors, monsterPositions, checkpointPositions, 0, 1, 1000000, maze.seed, 1);
+    WorldSnapshot world;
+    sim.takeSnapshot(world);
+    if (!sim.start()) {
+        cerr << "Unable to start the game simulation" << endl;
+        return;
+    }
+
+    const char keys[] = {'w', 'a', 's', 'd'};
+    const long moves = static_cast<long>(runs) * 1000;
+    long posted = 0;
+    long snapshots = 0;
+    int encountersHandled = 0;
+    struct pollfd notify = {sim.notifyFd(), POLLIN, 0};
+    auto begin = chrono::steady_clock::now();
+    while (posted < moves && !world.win) {
+        if (sim.post({CommandType::Move, keys[rand() % 4]})) {
+            posted++;
+        } else {
+            this_thread::yield();
+        }
+        if (poll(&notify, 1, 0) > 0) {
+            uint64_t published;
+            if (read(sim.notifyFd(), &published, sizeof(published)) < 0) {
+                published = 0;
+            }
+        }
+        if (sim.takeSnapshot(world)) {
+            snapshots++;
+            if (world.encounter && world.encounterCount != encountersHandled) {
+                encountersHandled = world.encounterCount;
+                while (!sim.post({CommandType::EncounterResult, rand() % 2})) {
+                    this_thread::yield();
+                }
+            }
+        }
+    }
+    sim.stop();
+    sim.takeSnapshot(world);
+    auto end = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>(end - begin).count();
+    cout << "sim " << size << "x" << size << ": " << posted << " commands, " << snapshots << " snapshots, "
+         << world.encounterCount << " encounters, " << world.monsterPositions.size() << " monsters in "
+         << seconds * 1000 << " ms (" << posted / seconds << " commands/s)" << endl;
+}
+
+/**
+ * @brief Returns the key that moves the player from one cell to a neighbouring one.
+ * @param from The current cell.
+ * @param to The neighbouring cell to move to.
+ * @return 'w', 'a', 's' or 'd'.
+ */
+static char moveKey(const PathNode &from, const PathNode &to) {
+    if (to.row < from.row) {
+        return 'w';
+    }
+    if (to.row > from.row) {
+        return 's';
+    }
+    return to.col < from.col ? 'a' : 'd';
+}
+
+/**
+ * @brief Plays generated games from the entrance to the exit without a screen.
+ *
+ * Each game is built in the same order as mazegen builds one, saved and mapped back
+ * through the binary format like a resumed game, and then a GameSimulation is driven
+ * along the solution path one move at a time while the monsters tick every millisecond.
+ * The next move is only posted once a snapshot shows the last one applied, or dropped
+ * by an encounter. Every encounter is answered with a win. This is the training run of `make pgo`, so it
+ * goes through the same code as a real game apart from ncurses.
+ *
+ * @param size The side length of the mazes.
+ * @param runs The number of games to play.
+ */
+void benchmarkReplay(int size, int runs) {
+    const string binaryPath = "mazeBench.bin";
+    long moves = 0;
+    int encounters = 0;
+    auto begin = chrono::steady_clock::now();
+    for (int game = 0; game < runs; game++) {
+        Maze maze(size, size, deriveSeed(size, game));
+        maze.generateMaze(maze.startX, maze.startY);
+        vector<PathNode> path = maze.solve();
+        maze.placeCheckpoints();
+        maze.markPath(path);
+        maze.placeMonsters(0.5f);
+        maze.saveMaze(binaryPath);
+
+        vector<string> mazemap;
+        CorridorGraph corridors;
+        vector<pair<int, int>> monsterPositions;
+        vector<pair<int, int>> checkpointPositions;
+        {
+            MappedMaze mapped(binaryPath);
+            if (!mapped.isOpen()) {
+                cerr << "Unable to load " << binaryPath << endl;
+                return;
+            }
+            for (int y = 0; y < mapped.height(); y++) {
+                mazemap.emplace_back(mapped.row(y), mapped.width());
+            }
+            corridors = CorridorGraph(reinterpret_cast<const unsigned char *>(mapped.cells()), mapped.width(),
+                                      mapped.height(), '#');
+            for (int i = 0; i < mapped.monsterCount(); i++) {
+                mazemap[mapped.monsters()[i].row][mapped.monsters()[i].col] = ' ';
+                monsterPositions.emplace_back(mapped.monsters()[i].row, mapped.monsters()[i].col);
+            }
+            for (int i = 0; i < mapped.checkpointCount(); i++) {
+                checkpointPositions.emplace_back(mapped.checkpoints()[i].row, mapped.checkpoints()[i].col);
+            }
+        }
+
+        GameSimulation sim(mazemap, corridors, monsterPositions, checkpointPositions, path[0].row, path[0].col, 1000000,
+                           deriveSeed(maze.seed, SEED_STREAM_MONSTERS), 1);
+        WorldSnapshot world;
+        sim.takeSnapshot(world);
+        if (!sim.start()) {
+            cerr << "Unable to start the game simulation" << endl;
+            return;
+        }
+
+        vector<int> pathIndex(static_cast<size_t>(size) * size, -1);
+        for (size_t i = 0; i < path.size(); i++) {
+            pathIndex[static_cast<size_t>(path[i].row) * size + path[i].col] = static_cast<int>(i);
+        }
+        size_t at = 0;
+        bool waiting = false;
+        int encountersHandled = 0;
+        struct pollfd notify = {sim.notifyFd(), POLLIN, 0};
+        while (!world.win && !world.gameOver && at + 1 < path.size()) {
+            if (!waiting) {
+                if (sim.post({CommandType::Move, moveKey(path[at], path[at + 1])})) {
+                    waiting = true;
+                    moves++;
+                }
+            }
+            if (poll(&notify, 1, 1000) > 0) {
+                uint64_t published;
+                if (read(sim.notifyFd(), &published, sizeof(published)) < 0) {
+                    published = 0;
+                }
+            }
+            if (!sim.takeSnapshot(world)) {
+                continue;
+            }
+            int reached = pathIndex[static_cast<size_t>(world.playerPosY) * size + world.playerPosX];
+            if (reached >= 0 && static_cast<size_t>(reached) != at) {
+                at = reached;
+                waiting = false;
+            }
+            if (world.encounter) {
+                if (world.encounterCount != encountersHandled) {
+                    encountersHandled = world.encounterCount;
+                    while (!sim.post({CommandType::EncounterResult, 0})) {
+                        this_thread::yield();
+                    }
+                }
+                waiting = false;
+            }
+        }
+        sim.stop();
+        encounters += encountersHandled;
+    }
+    auto end = chrono::steady_clock::now();
+    remove(binaryPath.c_str());
+    double seconds = chrono::duration<double>(end - begin).count();
+    cout << "replay " << size << "x" << size << ": " << runs << " games, " << moves << " moves, " << encounters
+         << " encounters in " << seconds * 1000 << " ms" << endl;
+}
+
+/**
+ * @brief Times one batch step of a large monster population.
+ *
+ * 100000 monsters are dropped on random open cells of a size x size maze, then the
+ * whole swarm is stepped `runs` times and the average time per tick is printed.
+ *
+ * @param size The side length of the maze.
+ * @param runs The number of ticks.
+ */
+void benchmarkSwarm(int size, int runs) {
+    const int count = 100000;
+    Maze maze(size, size);
+    maze.generateMaze(maze.startX, maze.startY);
+    vector<string> mazemap = maze.toRows();
+    MonsterSwarm swarm(maze.corridors, size, maze.seed);
+    while (swarm.size() < count) {
+        int y = 1 + rand() % (size - 2);
+        int x = 1 + rand() % (size - 2);
+        if (mazemap[y][x] != '#') {
+            swarm.add(y, x);
+        }
+    }
+
+    bool hit = false;
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        swarm.step();
+        hit = swarm.occupies(size - 1, size - 2) || hit;
+    }
+    auto end = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(end - begin).count() / runs;
+    cout << "swarm " << size << "x" << size << ": " << count << " monsters, " << ms << " ms/tick ("
+         << ms * 1e6 / count << " ns/monster" << (hit ? ", exit reached" : "") << ")" << endl;
+}
+
+/**
+ * @brief Plays minesweeper games with the solver and reports throughput and win rate.
+ *
+ * For the smallest and largest encounter boards and a range of mine densities, starting
+ * at the game's own, `games` boards are generated with minefieldgen() around a random
+ * first click and played to the end by MinesweeperSolver on a pool of threads. Game i
+ * of each configuration uses seed i, so the results do not depend on the thread count.
+ *
+ * The same games are then replayed, untimed, with guessing off to check that the solver
+ * only acts on sound deductions: such a game must never hit a mine, and every flag left
+ * on its board must sit on a mine. The violations are printed per configuration.
+ *
+ * @param games The number of games per board size and density.
+ * @param threads The number of worker threads; values below 1 mean one per hardware thread.
+ * @return The number of games without guessing that hit a mine or flagged a safe cell.
+ */
+int benchmarkAutoplay(int games, int threads) {
+    if (threads < 1) {
+        threads = defaultThreadCount();
+    }
+    const double densities[] = {static_cast<double>(MINES) / (MSIZE * MSIZE), 0.12, 0.16, 0.20};
+    long unsound = 0;
+    for (int size : {MSIZE, MSIZE_MAX}) {
+        for (double density : densities) {
+            const int mines = static_cast<int>(density * size * size + 0.5);
+            vector<MinesweeperSolver> solvers(threads);
+            vector<Board> minefields(threads, Board(size, size));
+            atomic<long> wins{0};
+            atomic<long> guesses{0};
+            auto begin = chrono::steady_clock::now();
+            parallelFor(games, threads, [&](int index, int worker) {
+                mt19937_64 rng(index);
+                int row = static_cast<int>(rng() % size);
+                int col = static_cast<int>(rng() % size);
+                minefieldgen(minefields[worker], mines, rng, row, col);
+                GameBoard board(minefields[worker]);
+                SolveResult result = solvers[worker].play(minefields[worker], board, row, col, rng);
+                wins.fetch_add(result.outcome == SolveOutcome::Cleared, memory_order_relaxed);
+                guesses.fetch_add(result.guesses, memory_order_relaxed);
+            });
+            auto end = chrono::steady_clock::now();
+            double seconds = chrono::duration<double>(end - begin).count();
+            cout << "autoplay " << size << "x" << size << ", " << mines << " mines (" << density * 100
+                 << "%): " << games << " games on " << min(threads, games) << " threads in " << seconds * 1000
+                 << " ms, " << games / seconds << " games/s, win rate " << 100.0 * wins / games << "%, "
+                 << static_cast<double>(guesses) / games << " guesses/game" << endl;
+
+            atomic<long> deduced{0};
+            atomic<long> hitMine{0};
+            atomic<long> wrongFlags{0};
+            parallelFor(games, threads, [&](int index, int worker) {
+                mt19937_64 rng(index);
+                int row = static_cast<int>(rng() % size);
+                int col = static_cast<int>(rng() % size);
+                minefieldgen(minefields[worker], mines, rng, row, col);
+                const Board &minefield = minefields[worker];
+                GameBoard board(minefield);
+                SolveResult result = solvers[worker].play(minefield, board, row, col, rng, false);
+                int wrong = 0;
+                for (size_t i = 0; i < board.size(); i++) {
+                    wrong += board.data()[i] == 'F' && minefield.data()[i] != 'X';
+                }
+                deduced.fetch_add(result.outcome == SolveOutcome::Cleared, memory_order_relaxed);
+                hitMine.fetch_add(result.outcome == SolveOutcome::HitMine, memory_order_relaxed);
+                wrongFlags.fetch_add(wrong > 0, memory_order_relaxed);
+            });
+            cout << "autoplay " << size << "x" << size << ", " << mines << " mines without guessing: "
+                 << 100.0 * deduced / games << "% cleared, " << hitMine << " hit a mine, " << wrongFlags
+                 << " flagged a safe cell" << endl;
+            unsound += hitMine + wrongFlags;
+        }
+    }
+    return static_cast<int>(min(unsound, static_cast<long>(INT_MAX)));
+}
+
+/**
+ * @brief Times no-guess minefield generation and reports how many candidates it takes.
+ *
+ * For encounter board sizes from MSIZE to MSIZE_MAX at the game's mine density and two
+ * denser ones, `boards` minefields are generated one after another around a random first
+ * click, each spread over `threads` workers. The average number of candidates per board,
+ * the boards for which no candidate could be cleared and the mean, median and 99th
+ * percentile time per board are printed.
+ *
+ * @param boards The number of boards per size and density.
+ * @param threads The number of worker threads per board; values below 1 mean one per hardware thread.
+ */
+void benchmarkNoGuess(int boards, int threads) {
+    const double densities[] = {static_cast<double>(MINES) / (MSIZE * MSIZE), 0.16, 0.20};
+    for (int size : {MSIZE, (MSIZE + MSIZE_MAX) / 2, MSIZE_MAX}) {
+        for (double density : densities) {
+            const int mines = static_cast<int>(density * size * size + 0.5);
+            vector<double> latencies;
+            long attempts = 0;
+            int failed = 0;
+            for (int i = 0; i < boards; i++) {
+                mt19937_64 rng(i);
+                int row = static_cast<int>(rng() % size);
+                int col = static_cast<int>(rng() % size);
+                NoGuessStats stats;
+                auto begin = chrono::steady_clock::now();
+                Board minefield = generateNoGuessMinefield(rng(), size, mines, row, col, threads, &stats);
+                auto end = chrono::steady_clock::now();
+                latencies.push_back(chrono::duration<double, micro>(end - begin).count());
+                attempts += stats.attempts;
+                failed += !stats.solved;
+            }
+            sort(latencies.begin(), latencies.end());
+            double total = 0;
+            for (double latency : latencies) {
+                total += latency;
+            }
+            cout << "noguess " << size << "x" << size << ", " << mines << " mines (" << density * 100
+                 << "%): " << static_cast<double>(attempts) / boards << " attempts/board, " << failed
+                 << " unsolved, " << total / boards << " us mean, " << latencies[boards / 2] << " us p50, "
+                 << latencies[min(boards - 1, boards * 99 / 100)] << " us p99" << endl;
+        }
+    }
+}
+
+/**
+ * @brief Times how long an encounter waits for its minefield, with and without the pool.
+ *
+ * `encounters` encounters are simulated, `gapMs` milliseconds apart like encounters in the
+ * maze, with the board size growing from MSIZE to MSIZE_MAX as if the player crossed the
+ * maze from top to bottom; the pool is told the size before each gap, as the game does
+ * when the player moves. An encounter is timed from
+ * the moment it starts until its board is ready to be drawn: the minefield is taken from
+ * a MinefieldPool and the centre is revealed, the work minesweeper() does before its
+ * first frame. With the pool stopped every minefield is generated on demand, which is
+ * what each encounter did before the pool. The median and 99th percentile are printed
+ * for ordinary and no-guess minefields, with the number of pool misses.
+ *
+ * @param encounters The number of encounters per configuration.
+ * @param gapMs The time between two encounters in milliseconds.
+ */
+void benchmarkEncounters(int encounters, int gapMs) {
+    for (bool noGuess : {false, true}) {
+        for (bool pooled : {false, true}) {
+            MinefieldPool pool(0, noGuess);
+            if (pooled) {
+                pool.start();
+            }
+            FloodScratch scratch;
+            vector<double> latencies;
+            for (int encounter = 1; encounter <= encounters; encounter++) {
+                int size = MSIZE + (MSIZE_MAX - MSIZE + 1) * (encounter - 1) / encounters;
+                pool.expect(size);
+                this_thread::sleep_for(chrono::milliseconds(gapMs));
+                auto begin = chrono::steady_clock::now();
+                Board minefield = pool.take(encounter, size);
+                GameBoard board(minefield);
+                revealPos(minefield, board, size / 2, size / 2, scratch);
+                auto end = chrono::steady_clock::now();
+                latencies.push_back(chrono::duration<double, micro>(end - begin).count());
+            }
+            pool.stop();
+            sort(latencies.begin(), latencies.end());
+            cout << "encounter " << (noGuess ? "no-guess" : "ordinary") << ", " << (pooled ? "pooled" : "on demand")
+                 << ": " << latencies[encounters / 2] << " us p50, "
+                 << latencies[min(encounters - 1, encounters * 99 / 100)] << " us p99, " << pool.misses() << "/"
+                 << encounters << " generated on demand" << endl;
+        }
+    }
+}
+
+/**
+ * @brief Checks that BitBoard plays exactly like Board and GameBoard.
+ *
+ * Each of `games` games gets a random width and height up to 130, so rows span one to
+ * three words, a random mine density from 5% to 25% and a random first click. The
+ * minefield is generated into a Board and handed to the BitBoard through its constructor,
+ * through saveMinefield() and loadMinefield(), or the other way round: generated by the
+ * BitBoard version of minefieldgen() and copied into the Board. Both boards then play the
+ * same random reveals and flags until a mine is hit or the board is cleared. After every
+ * move the return values of revealPos(), the counters, checkIfGameWin() and every cell
+ * of at() must agree; the first mismatch of a game is printed.
+ *
+ * @param games The number of games to play.
+ * @return The number of games with a mismatch.
+ */
+int benchmarkVerify(int games) {
+    char scratch[] = "/tmp/mazeBench.XXXXXX";
+    char *previous = getcwd(nullptr, 0);
+    if (mkdtemp(scratch) == nullptr || chdir(scratch) != 0 || mkdir(".gameConfig", 0755) != 0) {
+        cerr << "Unable to create a scratch directory for the minefield file" << endl;
+        free(previous);
+        return 1;
+    }
+
+    FloodScratch flood;
+    int mismatches = 0;
+    long moves = 0;
+    for (int game = 0; game < games; game++) {
+        mt19937_64 rng(game);
+        int width = 3 + static_cast<int>(rng() % 128);
+        int height = 3 + static_cast<int>(rng() % 128);
+        int mines = static_cast<int>((0.05 + 0.2 * (rng() % 1000) / 1000.0) * width * height);
+        int row = static_cast<int>(rng() % height);
+        int col = static_cast<int>(rng() % width);
+
+        Board minefield(width, height);
+        BitBoard bits(width, height);
+        if (game % 3 == 0) {
+            minefieldgen(minefield, mines, rng, row, col);
+            bits = BitBoard(minefield);
+        } else if (game % 3 == 1) {
+            minefieldgen(minefield, mines, rng, row, col);
+            saveMinefield(minefield);
+            loadMinefield(bits);
+        } else {
+            minefieldgen(bits, mines, rng, row, col);
+            for (int i = 0; i < height; i++) {
+                for (int j = 0; j < width; j++) {
+                    minefield.at(i, j) = bits.minefieldAt(i, j);
+                }
+            }
+        }
+        GameBoard board(minefield);
+
+        string error;
+        for (int i = 0; i < height && error.empty(); i++) {
+            for (int j = 0; j < width && error.empty(); j++) {
+                if (bits.minefieldAt(i, j) != minefield.at(i, j)) {
+                    error = "minefield differs at (" + to_string(i) + ", " + to_string(j) + ")";
+                }
+            }
+        }
+
+        bool alive = true;
+        for (int move = 0; error.empty() && alive && !checkIfGameWin(board); move++) {
+            bool flag = move > 0 && rng() % 5 == 0;
+            // Reveals mostly avoid mines so that games run long enough to open most of the board
+            for (int tries = 0; move > 0 && tries < (flag ? 1 : 8); tries++) {
+                row = static_cast<int>(rng() % height);
+                col = static_cast<int>(rng() % width);
+                if (flag || (minefield.at(row, col) != 'X' && board.at(row, col) == '#')) {
+                    break;
+                }
+            }
+            string action = flag ? "flag" : "reveal";
+            int covered = board.remainingSafe();
+            if (flag) {
+                board.toggleFlag(row, col);
+                bits.toggleFlag(row, col);
+            } else {
+                bool safe = revealPos(minefield, board, row, col, flood);
+                if (safe != revealPos(bits, row, col)) {
+                    error = "revealPos() differs";
+                }
+                alive = safe;
+            }
+            moves++;
+            if (board.remainingSafe() != bits.remainingSafe() || board.remainingMines() != bits.remainingMines() ||
+                checkIfGameWin(board) != checkIfGameWin(bits)) {
+                error = "counters differ";
+            }
+            // A move that uncovers at most one cell can only change the cell it was made on
+            bool opened = covered - board.remainingSafe() > 1 || !alive || checkIfGameWin(board);
+            for (int i = opened ? 0 : row; i < (opened ? height : row + 1) && error.empty(); i++) {
+                for (int j = opened ? 0 : col; j < (opened ? width : col + 1) && error.empty(); j++) {
+                    if (board.at(i, j) != bits.at(i, j)) {
+                        error = "cell (" + to_string(i) + ", " + to_string(j) + ") differs";
+                    }
+                }
+            }
+            if (!error.empty()) {
+                error += " after " + action + " (" + to_string(row) + ", " + to_string(col) + ") on move " +
+                         to_string(move);
+            }
+        }
+        if (!error.empty()) {
+            mismatches++;
+            cout << "verify game " << game << ", " << width << "x" << height << ", " << mines << " mines: " << error
+                 << endl;
+        }
+    }
+
+    remove(".gameConfig/minefield.txt");
+    rmdir(".gameConfig");
+    if (previous == nullptr || chdir(previous) != 0) {
+        cerr << "Unable to return to the working directory" << endl;
+    }
+    free(previous);
+    rmdir(scratch);
+
+    cout << "verify: " << games << " games, " << moves << " moves, " << mismatches
+         << " with BitBoard and GameBoard differing" << endl;
+    return mismatches;
+}
+
+/**
+ * @brief Entry point of the headless maze benchmark.
+ *
+ * Usage: mazeBench gen|solve|place|load|sim|replay|swarm [size] [runs]
+ *        mazeBench suite [maxSize]
+ *        mazeBench autoplay [games] [threads]
+ *        mazeBench noguess [boards] [threads]
+ *        mazeBench encounter [encounters] [gapMs]
+ *        mazeBench verify [games]
+ *
+ * The suite mode runs every benchmark for side lengths up to maxSize (4095 by default)
+ * and prints the results as JSON on stdout. The autoplay mode plays `games` minesweeper
+ * games (100000 by default) per board size and mine density and fails if the solver
+ * makes an unsound move when it may not guess, the noguess mode generates
+ * `boards` no-guess minefields (1000 by default) for each. The encounter mode times
+ * `encounters` encounters (200 by default), `gapMs` milliseconds (20 by default) apart,
+ * with and without the minefield pool. The verify mode plays `games` games (20000 by
+ * default) on BitBoard and GameBoard side by side and fails if they ever differ.
+ *
+ * @return int Returns 0 on success, 1 on an unknown mode, if the suite cannot run, if the
+ *         solver makes an unsound move in autoplay, if a solve is over budget or if verify
+ *         finds a mismatch.
+ */
+int main(int argc, char *argv[]) {
+    string mode = argc > 1 ? argv[1] : "gen";
+    if (mode == "suite") {
+        return runBenchmarkSuite(argc > 2 ? atoi(argv[2]) : 4095, cout);
+    }
+    if (mode == "autoplay") {
+        return benchmarkAutoplay(max(argc > 2 ? atoi(argv[2]) : 100000, 1), argc > 3 ? atoi(argv[3]) : 0) == 0 ? 0 : 1;
+    }
+    if (mode == "noguess") {
+        benchmarkNoGuess(max(argc > 2 ? atoi(argv[2]) : 1000, 1), argc > 3 ? atoi(argv[3]) : 0);
+        return 0;
+    }
+    if (mode == "encounter") {
+        benchmarkEncounters(max(argc > 2 ? atoi(argv[2]) : 200, 1), max(argc > 3 ? atoi(argv[3]) : 20, 0));
+        return 0;
+    }
+    if (mode == "verify") {
+        return benchmarkVerify(max(argc > 2 ? atoi(argv[2]) : 20000, 1)) == 0 ? 0 : 1;
+    }
+    int size = argc > 2 ? atoi(argv[2]) : SIZE;
+    int runs = argc > 3 ? atoi(argv[3]) : 10;
+    if (size < 7) {
+        size = 7;
+    }
+    if (size % 2 == 0) {
+        size++;
+    }
+    if (runs <= 0) {
+        runs = 1;
+    }
+
+    if (mode == "gen") {
+        benchmarkGeneration(size, runs);
+    } else if (mode == "solve") {
+        return benchmarkSolver(size, runs) == 0 ? 0 : 1;
+    } else if (mode == "place") {
+        benchmarkPlacement(size, runs);
+    } else if (mode == "load") {
+        benchmarkLoad(size, runs);
+    } else if (mode == "sim") {
+        benchmarkSimulation(size, runs);
+    } else if (mode == "replay") {
+        benchmarkReplay(size, runs);
+    } else if (mode == "swarm") {
+        benchmarkSwarm(size, runs);
+    } else {
+        cerr << "Usage: " << argv[0] << " gen|solve|place|load|sim|replay|swarm [size] [runs]" << endl;
+        cerr << "       " << argv[0] << " suite [maxSize]" << endl;
+        cerr << "       " << argv[0] << " autoplay [games] [threads]" << endl;
+        cerr << "       " << argv[0] << " noguess [boards] [threads]" << endl;
+        cerr << "       " << argv[0] << " encounter [encounters] [gapMs]" << endl;
+        cerr << "       " << argv[0] << " verify [games]" << endl;
+        return 1;
+    }
+    return 0;
+}
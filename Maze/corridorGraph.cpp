@@ -0,0 +1,337 @@
+#include "corridorGraph.h"
+#include <climits>
+#include <functional>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+#define UNVISITED INT_MIN // owner value of a corridor cell no walk has reached yet
+
+static const int stepRow[4] = {-1, 1, 0, 0};
+static const int stepCol[4] = {0, 0, -1, 1};
+
+/**
+ * @brief Returns the index in stepRow/stepCol of a unit step.
+ *
+ * @param dirRow The row step.
+ * @param dirCol The column step.
+ * @return 0 for up, 1 for down, 2 for left and 3 for right.
+ */
+static int directionIndex(int dirRow, int dirCol) {
+    if (dirRow != 0) {
+        return dirRow < 0 ? 0 : 1;
+    }
+    return dirCol < 0 ? 2 : 3;
+}
+
+/**
+ * @brief Builds the graph of a grid.
+ *
+ * 1. Every walkable cell without exactly two walkable neighbours, and every pinned
+ *    cell, becomes a node.
+ * 2. From each node, every direction not yet covered is walked until the next node;
+ *    the cells on the way form one edge, which covers the matching direction at
+ *    both ends.
+ * 3. Corridors that close on themselves without any node get one promoted to a node.
+ * 4. The corridors of each node are gathered into one contiguous array, and a
+ *    union-find over the edges tells whether any of them closes a cycle.
+ *
+ * @param grid The grid, row-major with width * height cells.
+ * @param width The number of columns of the grid.
+ * @param height The number of rows of the grid.
+ * @param wall The cell value that blocks movement.
+ * @param pinned Walkable cells that must become nodes.
+ */
+CorridorGraph::CorridorGraph(const unsigned char *grid, int width, int height, unsigned char wall,
+                             const vector<PathNode> &pinned)
+    : width(width), height(height), owner(static_cast<size_t>(width) * height, -1) {
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+            if (!isOpen(grid, wall, row, col)) {
+                continue;
+            }
+            int neighbours = 0;
+            for (int d = 0; d < 4; d++) {
+                neighbours += isOpen(grid, wall, row + stepRow[d], col + stepCol[d]);
+            }
+            if (neighbours == 2) {
+                owner[static_cast<size_t>(row) * width + col] = UNVISITED;
+            } else {
+                addNode(row, col);
+            }
+        }
+    }
+    for (const PathNode &cell : pinned) {
+        if (isOpen(grid, wall, cell.row, cell.col) && nodeAt(cell.row, cell.col) < 0) {
+            addNode(cell.row, cell.col);
+        }
+    }
+
+    // nodeEdge[node * 4 + d] is the edge leaving node in direction d, -1 while not walked
+    vector<int> nodeEdge(nodes.size() * 4, -1);
+    auto walkNode = [&](int node) {
+        for (int d = 0; d < 4; d++) {
+            if (nodeEdge[node * 4 + d] < 0 &&
+                isOpen(grid, wall, nodes[node].row + stepRow[d], nodes[node].col + stepCol[d])) {
+                walk(node, stepRow[d], stepCol[d], grid, wall, nodeEdge);
+            }
+        }
+    };
+    for (int node = 0; node < nodeCount(); node++) {
+        walkNode(node);
+    }
+    for (size_t i = 0; i < owner.size(); i++) {
+        if (owner[i] == UNVISITED) {
+            int node = addNode(static_cast<int>(i / width), static_cast<int>(i % width));
+            nodeEdge.resize(nodes.size() * 4, -1);
+            walkNode(node);
+        }
+    }
+
+    linkStart.assign(nodes.size() + 1, 0);
+    for (const CorridorEdge &edge : edges) {
+        linkStart[edge.from + 1]++;
+        linkStart[edge.to + 1]++;
+    }
+    for (size_t node = 0; node < nodes.size(); node++) {
+        linkStart[node + 1] += linkStart[node];
+    }
+    links.resize(linkStart.back());
+    vector<int> next(linkStart.begin(), linkStart.end() - 1);
+    for (int e = 0; e < edgeCount(); e++) {
+        links[next[edges[e].from]++] = CorridorLink{e, true};
+        links[next[edges[e].to]++] = CorridorLink{e, false};
+    }
+    vector<int> root(nodes.size());
+    for (size_t node = 0; node < nodes.size(); node++) {
+        root[node] = static_cast<int>(node);
+    }
+    auto find = [&root](int node) {
+        while (root[node] != node) {
+            node = root[node] = root[root[node]];
+        }
+        return node;
+    };
+    for (const CorridorEdge &edge : edges) {
+        int a = find(edge.from);
+        int b = find(edge.to);
+        if (a == b) {
+            forest = false;
+            break;
+        }
+        root[a] = b;
+    }
+
+    for (int node = 0; node < nodeCount(); node++) {
+        if (degree(node) == 1) {
+            deadEndNodes.push_back(node);
+        }
+    }
+}
+
+/**
+ * @brief Checks if a cell is inside the grid and walkable.
+ *
+ * @param grid The grid.
+ * @param wall The cell value that blocks movement.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @return true if the cell can be entered.
+ */
+bool CorridorGraph::isOpen(const unsigned char *grid, unsigned char wall, int row, int col) const {
+    return row >= 0 && row < height && col >= 0 && col < width && grid[static_cast<size_t>(row) * width + col] != wall;
+}
+
+/**
+ * @brief Turns a cell into a node.
+ *
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @return The index of the new node.
+ */
+int CorridorGraph::addNode(int row, int col) {
+    owner[static_cast<size_t>(row) * width + col] = nodeCount();
+    nodes.push_back({row, col});
+    return nodeCount() - 1;
+}
+
+/**
+ * @brief Follows a corridor from a node to the next node and records it as an edge.
+ *
+ * @param node The node to start from.
+ * @param dirRow The row step of the first move.
+ * @param dirCol The column step of the first move.
+ * @param grid The grid.
+ * @param wall The cell value that blocks movement.
+ * @param nodeEdge The edge of each (node, direction), updated at both ends.
+ */
+void CorridorGraph::walk(int node, int dirRow, int dirCol, const unsigned char *grid, unsigned char wall,
+                         vector<int> &nodeEdge) {
+    int edgeIndex = edgeCount();
+    CorridorEdge edge;
+    edge.from = node;
+    edge.firstCell = static_cast<int>(cells.size());
+    edge.dirRow = dirRow;
+    edge.dirCol = dirCol;
+    cells.push_back(nodes[node]);
+
+    int row = nodes[node].row + dirRow;
+    int col = nodes[node].col + dirCol;
+    while (owner[static_cast<size_t>(row) * width + col] == UNVISITED) {
+        owner[static_cast<size_t>(row) * width + col] = -(edgeIndex + 2);
+        cells.push_back({row, col});
+        // A corridor cell has two ways out; take the one we did not come from
+        for (int d = 0; d < 4; d++) {
+            if ((stepRow[d] != -dirRow || stepCol[d] != -dirCol) &&
+                isOpen(grid, wall, row + stepRow[d], col + stepCol[d])) {
+                dirRow = stepRow[d];
+                dirCol = stepCol[d];
+                break;
+            }
+        }
+        row += dirRow;
+        col += dirCol;
+    }
+
+    cells.push_back({row, col});
+    edge.to = owner[static_cast<size_t>(row) * width + col];
+    edge.length = static_cast<int>(cells.size()) - 1 - edge.firstCell;
+    edges.push_back(edge);
+    nodeEdge[edge.from * 4 + directionIndex(edge.dirRow, edge.dirCol)] = edgeIndex;
+    nodeEdge[edge.to * 4 + directionIndex(-dirRow, -dirCol)] = edgeIndex;
+}
+
+/**
+ * @brief Returns the node on a cell.
+ *
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @return The node index, or -1 if there is no node on the cell.
+ */
+int CorridorGraph::nodeAt(int row, int col) const {
+    if (row < 0 || row >= height || col < 0 || col >= width) {
+        return -1;
+    }
+    int value = owner[static_cast<size_t>(row) * width + col];
+    return value >= 0 ? value : -1;
+}
+
+/**
+ * @brief Finds the edge and offset of a walkable cell.
+ *
+ * Nodes use their first corridor. Corridor cells are found by scanning their edge,
+ * so the cost is the length of that corridor.
+ *
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @param edge Receives the edge index.
+ * @param offset Receives the offset along the edge.
+ * @return true if the cell lies on an edge.
+ */
+bool CorridorGraph::locate(int row, int col, int &edge, int &offset) const {
+    if (row < 0 || row >= height || col < 0 || col >= width) {
+        return false;
+    }
+    int value = owner[static_cast<size_t>(row) * width + col];
+    if (value >= 0) {
+        if (degree(value) == 0) {
+            return false;
+        }
+        const CorridorLink &first = link(value, 0);
+        edge = first.edge;
+        offset = first.forward ? 0 : edges[edge].length;
+        return true;
+    }
+    if (value == -1) {
+        return false;
+    }
+    edge = -value - 2;
+    for (offset = 1; offset < edges[edge].length; offset++) {
+        const PathNode &cell = edgeCell(edge, offset);
+        if (cell.row == row && cell.col == col) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Finds the shortest path between two nodes.
+ *
+ * @param start The cell to start from.
+ * @param goal The cell to reach.
+ * @return The cells from start to goal inclusive, or an empty vector if there is no such path.
+ */
+vector<PathNode> CorridorGraph::shortestPath(PathNode start, PathNode goal) const {
+    int startNode = nodeAt(start.row, start.col);
+    int goalNode = nodeAt(goal.row, goal.col);
+    if (startNode < 0 || goalNode < 0) {
+        return vector<PathNode>();
+    }
+
+    vector<int> distance(nodes.size(), INT_MAX);
+    vector<int> viaLink(nodes.size(), -1); // Index into links of the corridor used to reach each node
+    distance[startNode] = 0;
+    if (forest) {
+        vector<int> frontier(nodes.size()); // Every node is enqueued at most once
+        size_t head = 0;
+        size_t tail = 0;
+        frontier[tail++] = startNode;
+        while (head < tail && distance[goalNode] == INT_MAX) {
+            int node = frontier[head++];
+            for (int k = linkStart[node]; k < linkStart[node + 1]; k++) {
+                const CorridorEdge &edge = edges[links[k].edge];
+                int next = links[k].forward ? edge.to : edge.from;
+                if (distance[next] == INT_MAX) {
+                    distance[next] = distance[node] + edge.length;
+                    viaLink[next] = k;
+                    frontier[tail++] = next;
+                }
+            }
+        }
+    } else {
+        typedef pair<int, int> Entry; // (distance, node)
+        priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+        open.push(Entry(0, startNode));
+        while (!open.empty()) {
+            Entry top = open.top();
+            open.pop();
+            int node = top.second;
+            if (top.first != distance[node]) {
+                continue; // Stale entry, the node was reached more cheaply since
+            }
+            if (node == goalNode) {
+                break;
+            }
+            for (int k = linkStart[node]; k < linkStart[node + 1]; k++) {
+                const CorridorEdge &edge = edges[links[k].edge];
+                int next = links[k].forward ? edge.to : edge.from;
+                int cost = top.first + edge.length;
+                if (cost < distance[next]) {
+                    distance[next] = cost;
+                    viaLink[next] = k;
+                    open.push(Entry(cost, next));
+                }
+            }
+        }
+    }
+    if (distance[goalNode] == INT_MAX) {
+        return vector<PathNode>();
+    }
+
+    vector<PathNode> path(static_cast<size_t>(distance[goalNode]) + 1);
+    size_t step = path.size() - 1;
+    path[step] = nodes[goalNode];
+    for (int node = goalNode; node != startNode;) {
+        const CorridorLink &arrival = links[viaLink[node]];
+        const CorridorEdge &edge = edges[arrival.edge];
+        // Walk the corridor backwards from this node, writing the path from its end
+        for (int i = 1; i <= edge.length; i++) {
+            int offset = arrival.forward ? edge.length - i : i;
+            path[--step] = cells[edge.firstCell + offset];
+        }
+        node = arrival.forward ? edge.from : edge.to;
+    }
+    return path;
+}
@@ -0,0 +1,186 @@
+#ifndef CORRIDORGRAPH_H
+#define CORRIDORGRAPH_H
+
+#include <vector>
+#include "pathfinder.h"
+
+/**
+ * @struct CorridorEdge
+ * @brief A corridor between two nodes of a CorridorGraph.
+ *
+ * The cells of the corridor, both end nodes included, are stored contiguously
+ * in the graph; offset 0 is the `from` node and offset `length` is the `to` node.
+ */
+struct CorridorEdge {
+    int from; /**< The node at offset 0 */
+    int to; /**< The node at offset length */
+    int length; /**< The number of steps from one end to the other */
+    int firstCell; /**< Index of the `from` cell in the graph's cell list */
+    int dirRow; /**< The row step leaving `from` (-1, 0 or 1) */
+    int dirCol; /**< The column step leaving `from` (-1, 0 or 1) */
+};
+
+/**
+ * @struct CorridorLink
+ * @brief One corridor leaving a node.
+ */
+struct CorridorLink {
+    int edge; /**< The index of the edge */
+    bool forward; /**< True if the node is the edge's `from` end, so offsets increase along the link */
+};
+
+/**
+ * @class CorridorGraph
+ * @brief The walkable cells of a grid compressed into junctions, dead ends and the corridors between them.
+ *
+ * Every walkable cell that does not have exactly two walkable neighbours becomes a
+ * node; runs of two-neighbour cells become edges, whatever turns they take. The
+ * graph is built once in a single pass over the grid. Afterwards, dead ends are an
+ * O(1) lookup, a cell on an edge is addressed by (edge, offset), and shortest paths
+ * only visit nodes. For a perfect maze the graph is a tree.
+ */
+class CorridorGraph {
+public:
+    CorridorGraph() = default;
+
+    /**
+     * @brief Builds the graph of a grid.
+     * @param grid The grid, row-major with width * height cells
+     * @param width The number of columns of the grid
+     * @param height The number of rows of the grid
+     * @param wall The cell value that blocks movement; every other value is walkable
+     * @param pinned Walkable cells that must become nodes even inside a corridor
+     */
+    CorridorGraph(const unsigned char *grid, int width, int height, unsigned char wall,
+                  const std::vector<PathNode> &pinned = std::vector<PathNode>());
+
+    /**
+     * @brief Returns the number of nodes.
+     * @return The number of nodes
+     */
+    int nodeCount() const { return static_cast<int>(nodes.size()); }
+
+    /**
+     * @brief Returns the number of edges.
+     * @return The number of edges
+     */
+    int edgeCount() const { return static_cast<int>(edges.size()); }
+
+    /**
+     * @brief Returns the node on a cell.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     * @return The node index, or -1 if the cell is a wall, inside a corridor or out of bounds
+     */
+    int nodeAt(int row, int col) const;
+
+    /**
+     * @brief Returns the cell of a node.
+     * @param node The node index
+     * @return The (row, column) of the node
+     */
+    const PathNode &nodeCell(int node) const { return nodes[node]; }
+
+    /**
+     * @brief Returns the number of corridors leaving a node.
+     * @param node The node index
+     * @return The degree of the node
+     */
+    int degree(int node) const { return linkStart[node + 1] - linkStart[node]; }
+
+    /**
+     * @brief Returns one corridor leaving a node.
+     * @param node The node index
+     * @param k Which corridor, from 0 to degree(node) - 1
+     * @return The link to the corridor
+     */
+    const CorridorLink &link(int node, int k) const { return links[linkStart[node] + k]; }
+
+    /**
+     * @brief Returns an edge.
+     * @param edge The edge index
+     * @return The edge
+     */
+    const CorridorEdge &edgeAt(int edge) const { return edges[edge]; }
+
+    /**
+     * @brief Returns a cell along an edge.
+     * @param edge The edge index
+     * @param offset The number of steps from the `from` node, 0 to length
+     * @return The (row, column) of the cell
+     */
+    const PathNode &edgeCell(int edge, int offset) const { return cells[edges[edge].firstCell + offset]; }
+
+    /**
+     * @brief Returns a cell from the graph's cell list.
+     * @param index The position in the list; edge e's cells are edgeAt(e).firstCell to firstCell + length
+     * @return The (row, column) of the cell
+     */
+    const PathNode &cellAt(int index) const { return cells[index]; }
+
+    /**
+     * @brief Finds the edge and offset of a walkable cell.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     * @param edge Receives the edge index; for a node, any of its corridors
+     * @param offset Receives the offset of the cell along the edge
+     * @return True if the cell lies on an edge, false for walls and isolated nodes
+     */
+    bool locate(int row, int col, int &edge, int &offset) const;
+
+    /**
+     * @brief Checks if a cell is a dead end, i.e. a node with exactly one corridor.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     * @return True if the cell is a dead end
+     */
+    bool isDeadEnd(int row, int col) const {
+        int node = nodeAt(row, col);
+        return node >= 0 && degree(node) == 1;
+    }
+
+    /**
+     * @brief Returns every dead end.
+     * @return The node indices of all nodes with one corridor
+     */
+    const std::vector<int> &deadEnds() const { return deadEndNodes; }
+
+    /**
+     * @brief Checks if the graph has no cycles, as is the case for a perfect maze.
+     * @return True if every component is a tree
+     */
+    bool isForest() const { return forest; }
+
+    /**
+     * @brief Finds the shortest path between two nodes.
+     *
+     * In a forest the only path is the shortest, so a plain breadth-first search
+     * over the nodes finds it; otherwise Dijkstra's algorithm weighted by corridor
+     * length is used. The corridors of the result are then expanded back into cells.
+     *
+     * @param start The cell to start from; must be a node
+     * @param goal The cell to reach; must be a node
+     * @return The cells from start to goal inclusive, or an empty vector if either end
+     *         is not a node or the goal is unreachable
+     */
+    std::vector<PathNode> shortestPath(PathNode start, PathNode goal) const;
+
+private:
+    bool isOpen(const unsigned char *grid, unsigned char wall, int row, int col) const;
+    int addNode(int row, int col);
+    void walk(int node, int dirRow, int dirCol, const unsigned char *grid, unsigned char wall,
+              std::vector<int> &nodeEdge);
+
+    int width = 0; /**< The number of columns of the grid */
+    int height = 0; /**< The number of rows of the grid */
+    std::vector<int> owner; /**< Per cell: the node index, -1 for walls, or -(edge + 2) inside a corridor */
+    std::vector<PathNode> nodes; /**< The cell of every node */
+    std::vector<CorridorEdge> edges; /**< Every corridor */
+    std::vector<PathNode> cells; /**< The cells of all edges, edge after edge */
+    std::vector<int> linkStart; /**< The links of node n are links[linkStart[n] .. linkStart[n + 1]) */
+    std::vector<CorridorLink> links; /**< The corridors leaving each node */
+    std::vector<int> deadEndNodes; /**< The nodes with one corridor */
+    bool forest = true; /**< False if some corridor closes a cycle */
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#define SEED_STREAM_MONSTERS 0 // deriveSeed() stream for the starting directions of the monsters
+#define SEED_STREAM_MINEFIELDS 1 // deriveSeed() stream of the first encounter's minefield; encounter k adds k
+
+/**
+ * @brief The random number engine used everywhere in the game.
+ *
+ * One seed drives the whole new-game pipeline. Only the raw engine output is used
+ * (never a std:: distribution or std::shuffle, whose results differ between
+ * standard libraries), so a seed regenerates the same game bit for bit.
+ */
+typedef std::mt19937_64 GameRng;
+
+/**
+ * @brief Draws a seed from the operating system for a game started without --seed.
+ * @return A fresh 64-bit seed
+ */
+inline uint64_t freshSeed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+/**
+ * @brief Derives an independent seed for one consumer of the game seed.
+ *
+ * This is the splitmix64 finaliser applied to the seed offset by the stream number,
+ * so e.g. the monster directions and every minefield get their own sequence.
+ *
+ * @param seed The game seed
+ * @param stream A number identifying the consumer
+ * @return The derived seed
+ */
+inline uint64_t deriveSeed(uint64_t seed, uint64_t stream) {
+    uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Draws a number in [0, bound).
+ *
+ * The modulo bias is below 2^-40 for any bound the game uses.
+ *
+ * @param rng The engine
+ * @param bound The exclusive upper limit, greater than 0
+ * @return The number
+ */
+inline size_t randomBelow(GameRng &rng, size_t bound) {
+    return static_cast<size_t>(rng() % bound);
+}
+
+/**
+ * @brief Shuffles a range with Fisher-Yates using randomBelow().
+ * @param first The start of the range
+ * @param last The end of the range
+ * @param rng The engine
+ */
+template <typename Iterator>
+void shuffleRange(Iterator first, Iterator last, GameRng &rng) {
+    for (size_t i = static_cast<size_t>(last - first); i > 1; --i) {
+        std::swap(first[i - 1], first[randomBelow(rng, i)]);
+    }
+}
+
+#endif
@@ -0,0 +1,310 @@
+#include "gameSimulation.h"
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * @brief Sets up the simulation state and the monster swarm.
+ *
+ * The first snapshot is published right away
+ * so the UI has something to draw before the thread starts.
+ *
+ * @param mazemap The maze, one string per row, with monsters removed.
+ * @param corridors The corridor graph of the maze, which monsters patrol.
+ * @param monsterPositions The (row, column) starting positions of the monsters.
+ * @param checkpointPositions The (row, column) positions of the checkpoints.
+ * @param playerPosY The starting row of the player.
+ * @param playerPosX The starting column of the player.
+ * @param playerHP The starting health points of the player.
+ * @param seed The seed for the monster directions.
+ * @param tickMs The time between two monster moves in milliseconds.
+ * @param encounterCount The number of encounters of the game so far, restored from a save.
+ */
+GameSimulation::GameSimulation(const vector<string> &mazemap, const CorridorGraph &corridors,
+                               const vector<pair<int, int>> &monsterPositions,
+                               const vector<pair<int, int>> &checkpointPositions, int playerPosY, int playerPosX,
+                               int playerHP, uint64_t seed, int tickMs, int encounterCount)
+    : mazemap(mazemap), monsters(corridors, static_cast<int>(mazemap.size()), seed), checkpointPositions(checkpointPositions),
+      monstersFrozenUntil(chrono::steady_clock::now()), tickMs(tickMs) {
+    state.playerPosY = playerPosY;
+    state.playerPosX = playerPosX;
+    state.playerHP = playerHP;
+    state.encounterCount = encounterCount;
+
+    for (const auto &monster : monsterPositions) {
+        monsters.add(monster.first, monster.second);
+    }
+    publish();
+}
+
+/**
+ * @brief Stops the thread if it is still running and closes the file descriptors.
+ */
+GameSimulation::~GameSimulation() {
+    stop();
+    for (int fd : {commandFd, tickFd, snapshotFd}) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+/**
+ * @brief Creates the eventfds and the tick timer, then starts the simulation thread.
+ *
+ * @return true if the thread is running, false if a file descriptor could not be created.
+ */
+bool GameSimulation::start() {
+    commandFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    snapshotFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    tickFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (commandFd < 0 || snapshotFd < 0 || tickFd < 0) {
+        return false;
+    }
+
+    struct itimerspec tick = {};
+    tick.it_interval.tv_sec = tickMs / 1000;
+    tick.it_interval.tv_nsec = (tickMs % 1000) * 1000000L;
+    tick.it_value = tick.it_interval;
+    timerfd_settime(tickFd, 0, &tick, nullptr);
+
+    running = true;
+    worker = thread(&GameSimulation::run, this);
+    return true;
+}
+
+/**
+ * @brief Asks the simulation thread to finish and waits for it.
+ */
+void GameSimulation::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    running = false;
+    uint64_t one = 1;
+    if (write(commandFd, &one, sizeof(one)) < 0) {
+        // The thread also checks `running` on every tick, so it still stops
+    }
+    worker.join();
+}
+
+/**
+ * @brief Queues a command and wakes the simulation thread.
+ *
+ * @param command The command to queue.
+ * @return true if the command was queued, false if the queue is full.
+ */
+bool GameSimulation::post(const Command &command) {
+    if (!commands.push(command)) {
+        return false;
+    }
+    uint64_t one = 1;
+    return write(commandFd, &one, sizeof(one)) == sizeof(one) || errno == EAGAIN;
+}
+
+/**
+ * @brief Swaps the newest published snapshot into `out`.
+ *
+ * @param out Receives the snapshot; its old buffers are reused by the simulation.
+ * @return true if a new snapshot was taken, false if nothing was published since the last call.
+ */
+bool GameSimulation::takeSnapshot(WorldSnapshot &out) {
+    lock_guard<mutex> lock(snapshotMutex);
+    if (!fresh) {
+        return false;
+    }
+    swap(out, shared);
+    fresh = false;
+    return true;
+}
+
+/**
+ * @brief Copies the live state into the spare buffer and publishes it.
+ *
+ * The copy is made without holding the lock; only the swap is guarded.
+ */
+void GameSimulation::publish() {
+    spare = state;
+    monsters.positions(spare.monsterPositions);
+    {
+        lock_guard<mutex> lock(snapshotMutex);
+        swap(spare, shared);
+        fresh = true;
+    }
+    if (snapshotFd >= 0) {
+        uint64_t one = 1;
+        if (write(snapshotFd, &one, sizeof(one)) < 0) {
+            // The counter is already non-zero, so the UI will wake up anyway
+        }
+    }
+}
+
+/**
+ * @brief The simulation thread: waits for commands and ticks, applies them and publishes the result.
+ *
+ * Commands still queued when stop() is called are applied before the thread exits,
+ * and a final snapshot is always published.
+ */
+void GameSimulation::run() {
+    struct pollfd events[2] = {};
+    events[0].fd = commandFd;
+    events[0].events = POLLIN;
+    events[1].fd = tickFd;
+    events[1].events = POLLIN;
+
+    while (running) {
+        if (poll(events, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        bool changed = false;
+        uint64_t counter;
+        if (events[0].revents & POLLIN) {
+            if (read(commandFd, &counter, sizeof(counter)) < 0) {
+                counter = 0;
+            }
+            Command command;
+            while (commands.pop(command)) {
+                changed = applyCommand(command) || changed;
+            }
+        }
+        if (events[1].revents & POLLIN) {
+            if (read(tickFd, &counter, sizeof(counter)) < 0) {
+                counter = 0;
+            }
+            changed = tick() || changed;
+        }
+        if (changed) {
+            publish();
+        }
+    }
+
+    Command command;
+    while (commands.pop(command)) {
+        applyCommand(command);
+    }
+    publish();
+}
+
+/**
+ * @brief Applies one command from the UI.
+ *
+ * Moves are checked against the walls and ignored during an encounter or after
+ * the game has ended. Walking onto a monster starts an encounter at once, without
+ * waiting for the next tick, which the monster may use to step away. A lost encounter sends the player back to the nearest
+ * checkpoint and costs one health point; a won encounter freezes the monsters
+ * for ENCOUNTER_GRACE_SECONDS.
+ *
+ * @param command The command to apply.
+ * @return true if the state changed.
+ */
+bool GameSimulation::applyCommand(const Command &command) {
+    if (state.win || state.gameOver) {
+        return false;
+    }
+
+    if (command.type == CommandType::EncounterResult) {
+        if (!state.encounter) {
+            return false;
+        }
+        state.encounter = false;
+        if (command.value != 0) {
+            auto nearestCheckpoint = findNearestCheckpoint();
+            state.playerPosY = nearestCheckpoint.first;
+            state.playerPosX = nearestCheckpoint.second;
+            state.playerHP--;
+            state.gameOver = state.playerHP <= 0;
+        } else {
+            monstersFrozenUntil = chrono::steady_clock::now() + chrono::seconds(ENCOUNTER_GRACE_SECONDS);
+        }
+        return true;
+    }
+
+    if (state.encounter) {
+        return false;
+    }
+    int &y = state.playerPosY;
+    int &x = state.playerPosX;
+    switch (command.value) {
+        case 'w':
+            if (y > 0 && mazemap[y - 1][x] != '#') {
+                y--;
+            }
+            break;
+        case 's':
+            if (mazemap[y + 1][x] != '#') {
+                y++;
+            }
+            break;
+        case 'a':
+            if (mazemap[y][x - 1] != '#') {
+                x--;
+            }
+            break;
+        case 'd':
+            if (mazemap[y][x + 1] != '#') {
+                x++;
+            }
+            break;
+        default:
+            return false;
+    }
+    if (static_cast<size_t>(y) + 1 >= mazemap.size()) {
+        state.win = true;
+    }
+    checkEncounter();
+    return true;
+}
+
+/**
+ * @brief Advances the monsters by one step unless the game is paused.
+ *
+ * @return true if the monsters moved.
+ */
+bool GameSimulation::tick() {
+    if (state.encounter || state.win || state.gameOver || chrono::steady_clock::now() < monstersFrozenUntil) {
+        return false;
+    }
+    monsters.step();
+    checkEncounter();
+    return true;
+}
+
+/**
+ * @brief Starts an encounter if a monster stands on the player's cell.
+ */
+void GameSimulation::checkEncounter() {
+    if (!state.win && monsters.occupies(state.playerPosY, state.playerPosX)) {
+        state.encounter = true;
+        state.encounterCount++;
+    }
+}
+
+/**
+ * @brief Finds the checkpoint nearest to the player by Manhattan distance.
+ *
+ * @return The (row, column) of the nearest checkpoint, or the entrance if there are none.
+ */
+pair<int, int> GameSimulation::findNearestCheckpoint() const {
+    pair<int, int> nearestCheckpoint(0, 1);
+    int minDistance = INT_MAX;
+
+    for (const auto &checkpoint : checkpointPositions) {
+        int distance = abs(checkpoint.first - state.playerPosY) + abs(checkpoint.second - state.playerPosX);
+        if (distance < minDistance) {
+            minDistance = distance;
+            nearestCheckpoint = checkpoint;
+        }
+    }
+
+    return nearestCheckpoint;
+}
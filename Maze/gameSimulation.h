@@ -0,0 +1,148 @@
+#ifndef GAMESIMULATION_H
+#define GAMESIMULATION_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "monsterSwarm.h"
+#include "spscQueue.h"
+
+#define MONSTER_TICK_MS 500 // Time between two monster moves
+#define ENCOUNTER_GRACE_SECONDS 6 // Monsters stay still this long after the player wins a minesweeper game
+
+/**
+ * @struct WorldSnapshot
+ * @brief A consistent copy of the game state, published by the simulation for the UI.
+ */
+struct WorldSnapshot {
+    int playerPosY = 0; /**< The row of the player */
+    int playerPosX = 0; /**< The column of the player */
+    int playerHP = 0; /**< The health points of the player */
+    std::vector<std::pair<int, int>> monsterPositions; /**< The (row, column) positions of the monsters */
+    int encounterCount = 0; /**< The number of monster encounters so far */
+    bool encounter = false; /**< True while the simulation waits for the result of a minesweeper game */
+    bool win = false; /**< True once the player has reached the exit */
+    bool gameOver = false; /**< True once the player has run out of health points */
+};
+
+/**
+ * @enum CommandType
+ * @brief The kinds of commands the UI can send to the simulation.
+ */
+enum class CommandType {
+    Move, /**< Move the player; value is the key ('w', 'a', 's' or 'd') */
+    EncounterResult /**< Report the minesweeper result; value is 0 for a win */
+};
+
+/**
+ * @struct Command
+ * @brief A command sent from the UI thread to the simulation thread.
+ */
+struct Command {
+    CommandType type; /**< What to do */
+    int value; /**< The argument of the command */
+};
+
+/**
+ * @class GameSimulation
+ * @brief Owns the mutable game state and advances it on its own thread.
+ *
+ * Concurrency model:
+ * - The maze map is immutable while the simulation runs and is shared read-only.
+ * - The UI thread sends commands through a lock-free single-producer/single-consumer
+ *   queue and wakes the simulation with an eventfd.
+ * - The simulation thread alone mutates the player, monsters and HP. After every
+ *   change it fills a private snapshot and swaps it with the shared one under a
+ *   short lock, then signals notifyFd(). The UI swaps the shared snapshot out the
+ *   same way, so neither side ever reads a half-written state.
+ * - Monsters move on a fixed timestep driven by a timerfd.
+ * - The simulation never calls ncurses; the UI thread owns the screen.
+ */
+class GameSimulation {
+public:
+    /**
+     * @brief Sets up the simulation; the thread is started by start().
+     * @param mazemap The maze, one string per row, with monsters removed. Must outlive the simulation.
+     * @param corridors The corridor graph of the maze, which monsters patrol. Must outlive the simulation.
+     * @param monsterPositions The (row, column) starting positions of the monsters
+     * @param checkpointPositions The (row, column) positions of the checkpoints
+     * @param playerPosY The starting row of the player
+     * @param playerPosX The starting column of the player
+     * @param playerHP The starting health points of the player
+     * @param seed The seed for the monster directions
+     * @param tickMs The time between two monster moves in milliseconds
+     * @param encounterCount The number of encounters of the game so far, restored from a save
+     */
+    GameSimulation(const std::vector<std::string> &mazemap, const CorridorGraph &corridors,
+                   const std::vector<std::pair<int, int>> &monsterPositions,
+                   const std::vector<std::pair<int, int>> &checkpointPositions, int playerPosY, int playerPosX,
+                   int playerHP, uint64_t seed, int tickMs = MONSTER_TICK_MS, int encounterCount = 0);
+    ~GameSimulation();
+
+    GameSimulation(const GameSimulation &) = delete;
+    GameSimulation &operator=(const GameSimulation &) = delete;
+
+    /**
+     * @brief Starts the simulation thread.
+     * @return True if the thread is running, false if the timer or eventfds could not be created
+     */
+    bool start();
+
+    /**
+     * @brief Stops and joins the simulation thread. Queued commands are applied first.
+     */
+    void stop();
+
+    /**
+     * @brief Queues a command. Must only be called from one (the UI) thread.
+     * @param command The command to queue
+     * @return True if the command was queued, false if the queue is full
+     */
+    bool post(const Command &command);
+
+    /**
+     * @brief Takes the newest snapshot if one was published since the last call.
+     * @param out Receives the snapshot
+     * @return True if out was updated, false if nothing changed
+     */
+    bool takeSnapshot(WorldSnapshot &out);
+
+    /**
+     * @brief Returns an eventfd that becomes readable whenever a new snapshot is published.
+     * @return The file descriptor, to be used with poll()
+     */
+    int notifyFd() const { return snapshotFd; }
+
+private:
+    void run();
+    bool applyCommand(const Command &command);
+    bool tick();
+    void checkEncounter();
+    void publish();
+    std::pair<int, int> findNearestCheckpoint() const;
+
+    const std::vector<std::string> &mazemap; /**< The shared, read-only maze */
+    MonsterSwarm monsters; /**< The positions and directions of all monsters */
+    std::vector<std::pair<int, int>> checkpointPositions; /**< The (row, column) positions of the checkpoints */
+    WorldSnapshot state; /**< The live state, only touched by the simulation thread while it runs */
+    std::chrono::steady_clock::time_point monstersFrozenUntil; /**< Monsters do not move before this point */
+    int tickMs; /**< The time between two monster moves in milliseconds */
+
+    SpscQueue<Command, 256> commands; /**< Commands from the UI thread */
+    int commandFd = -1; /**< eventfd signalled by post() */
+    int tickFd = -1; /**< timerfd for the monster tick */
+    int snapshotFd = -1; /**< eventfd signalled by publish() */
+    std::atomic<bool> running{false}; /**< Cleared by stop() to end the thread */
+    std::thread worker; /**< The simulation thread */
+
+    std::mutex snapshotMutex; /**< Guards shared and fresh */
+    WorldSnapshot shared; /**< The newest published snapshot */
+    bool fresh = false; /**< True if shared has not been taken yet */
+    WorldSnapshot spare; /**< The buffer the simulation fills before publishing */
+};
+
+#endif
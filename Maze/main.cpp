@@ -1,230 +1,69 @@
 #include "mazeGame.h"
+#include "mazeFile.h"
+#include "mazeRenderer.h"
+#include "gameSimulation.h"
+#include "minefieldPool.h"
 #include "minesweeper.h"
-#include <climits>
-#include <future>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
 #include <ncurses.h>
 #include <string>
 #include <thread>
-#include <unordered_map>
 #include <fstream>
+#include <poll.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 
-unordered_map<int, pair<int, int>> monsterDirections;
-
-/**
- * @brief Checks if a given position in the maze is free to move to.
- *
- * This function determines if the specified coordinates (y, x) in the maze
- * are within bounds and not blocked by a wall ('#'). Additionally, it ensures
- * that the position (0, 1) is not considered free.
- *
- * @param mazemap A reference to a vector of strings representing the maze.
- * @param y The y-coordinate (row) to check.
- * @param x The x-coordinate (column) to check.
- * @return true if the position is within bounds, not a wall, and not (0, 1); false otherwise.
- */
-bool isFree(const vector<string> &mazemap, int y, int x) {
-    return y >= 0 && y < mazemap.size() && x >= 0 && x < mazemap[0].size() && mazemap[y][x] != '#' && (y != 0 || x != 1);
-}
-
-/**
- * @brief Moves the monster in the maze based on its current direction.
- * 
- * This function updates the position of a monster in the maze. If the monster
- * encounters an obstacle, it changes its direction to avoid the obstacle.
- * 
- * @param mazemap A reference to the maze represented as a vector of strings.
- * @param monsterPos A reference to the current position of the monster as a pair of integers (row, column).
- * @param monsterIndex The index of the monster in the monsterDirections vector.
- * 
- * The function first calculates the new position of the monster based on its
- * current direction. If the new position is not free (i.e., it is an obstacle),
- * the function attempts to change the monster's direction to either left or right
- * if it was moving vertically, or reverses its direction if it was moving horizontally.
- * After updating the direction, it recalculates the new position. If the new position
- * is free, it swaps the monster's current position with the new position in the maze.
- */
-void moveMonster(vector<string> &mazemap, pair<int, int> &monsterPos, int monsterIndex) {
-    pair<int, int> &direction = monsterDirections[monsterIndex];
-    pair<int, int> &pos = monsterPos;
-
-    int newY = pos.first + direction.first;
-    int newX = pos.second + direction.second;
-
-    if (!isFree(mazemap, newY, newX)) {
-        if (direction.first != 0) {
-            if (isFree(mazemap, pos.first, pos.second - 1)) {
-                direction = make_pair(0, -1);
-            } else if (isFree(mazemap, pos.first, pos.second + 1)) {
-                direction = make_pair(0, 1);
-            } else {
-                direction.first = -direction.first;
-            }
-        } else {
-            direction.second = -direction.second;
-        }
-        newY = pos.first + direction.first;
-        newX = pos.second + direction.second;
-    }
-
-    if (isFree(mazemap, newY, newX)) {
-        swap(mazemap[pos.first][pos.second], mazemap[newY][newX]);
-        pos.first = newY;
-        pos.second = newX;
-    }
-}
-
-/**
- * @brief Moves all monsters in the maze and checks if any monster has reached the player's position.
- * 
- * This function iterates through the list of monster positions, moves each monster by calling the 
- * moveMonster function, and checks if any monster's new position matches the player's position.
- * 
- * @param mazemap A reference to a vector of strings representing the maze layout.
- * @param monsterPositions A reference to a vector of pairs of integers representing the positions of the monsters.
- * @param playerPos A pair of integers representing the player's position.
- * @return true if any monster reaches the player's position, false otherwise.
- */
-bool moveMonsters(vector<string> &mazemap, vector<pair<int, int>> &monsterPositions, pair<int, int> playerPos) {
-    for (int i = 0; i < monsterPositions.size(); ++i) {
-        moveMonster(mazemap, monsterPositions[i], i);
-        if (monsterPositions[i] == playerPos) {
-            return true;
-        }
-    }
-    return false;
-}
-
-/**
- * @brief Displays the current state of the maze map on the screen.
- *
- * This function takes the original maze map and updates it to include the player's
- * position and the positions of the monsters. It then prints the updated map to the screen.
- *
- * @param originalMazemap A vector of strings representing the original maze map.
- * @param screenSizeY The height of the screen in lines.
- * @param linepointer The current line pointer indicating the top line of the visible screen.
- * @param playerPosY The Y-coordinate of the player's position in the maze.
- * @param playerPosX The X-coordinate of the player's position in the maze.
- * @param monsterPositions A vector of pairs representing the positions of the monsters in the maze.
- * @param playerHP The current health points of the player.
- */
-void displayMap(const vector<string> &originalMazemap, int screenSizeY, int linepointer, int playerPosY, int playerPosX, const vector<pair<int, int>> &monsterPositions, int playerHP) {
-    vector<string> mazemap = originalMazemap;
-
-    if (playerPosY >= linepointer && playerPosY < linepointer + screenSizeY) {
-        mazemap[playerPosY][playerPosX] = 'P';
-    }
-
-    for (const auto &monsterPos : monsterPositions) {
-        if (monsterPos.first >= linepointer && monsterPos.first < linepointer + screenSizeY) {
-            mazemap[monsterPos.first][monsterPos.second] = 'M';
-        }
-    }
-
-    move(0, 0);
-    int i = 0;
-    for (string mazeStrip : mazemap) {
-        if (i < (screenSizeY + linepointer) && i >= linepointer) {
-            for (int j = 0; j < mazeStrip.length(); j++) {
-                if (i == playerPosY && j == playerPosX) {
-                    attron(COLOR_PAIR(2));
-                    printw("P ");
-                    attroff(COLOR_PAIR(2));
-                } else if (mazeStrip[j] == '#') {
-                    printw("##");
-                } else if (mazeStrip[j] == 'M') {
-                    attron(COLOR_PAIR(8));
-                    printw("M ");
-                    attroff(COLOR_PAIR(8));
-                } else if (mazeStrip[j] == 'C') {
-                    attron(COLOR_PAIR(2));
-                    printw("C ");
-                    attroff(COLOR_PAIR(2));
-                } else {
-                    printw("  ");
-                }
-            }
-            printw("\n");
-        }
-        i++;
-    }
-    mvprintw(screenSizeY / 2, mazemap.size() + 60, "HP: %d", playerHP);
-    refresh();
-}
-
-/**
- * @brief Finds the nearest checkpoint to the player's current position.
- *
- * This function iterates through a list of checkpoints and calculates the Manhattan distance
- * from the player's current position to each checkpoint. It returns the checkpoint with the
- * smallest distance.
- *
- * @param checkpoints A vector of pairs representing the coordinates (y, x) of the checkpoints.
- * @param playerPosY The y-coordinate of the player's current position.
- * @param playerPosX The x-coordinate of the player's current position.
- * @return A pair of integers representing the coordinates (y, x) of the nearest checkpoint.
- */
-pair<int, int> findNearestCheckpoint(const vector<pair<int, int>> &checkpoints, int playerPosY, int playerPosX) {
-    pair<int, int> nearestCheckpoint;
-    int minDistance = INT_MAX;
-
-    for (const auto &checkpoint : checkpoints) {
-        int distance = abs(checkpoint.first - playerPosY) + abs(checkpoint.second - playerPosX);
-        if (distance < minDistance) {
-            minDistance = distance;
-            nearestCheckpoint = checkpoint;
-        }
-    }
-
-    return nearestCheckpoint;
-}
-
 /**
  * @brief Stores the current status of the player to a file.
  *
  * This function writes the player's current position (Y and X coordinates),
- * health points (HP), and a line pointer to a status file located at
- * ".gameConfig/status.txt". If the file cannot be opened, an error message
+ * health points (HP), a line pointer and the number of encounters so far to a
+ * status file located at ".gameConfig/status.txt". The encounter count lets a
+ * resumed game continue with the minefields that follow the ones already played. If the file cannot be opened, an error message
  * is printed to the standard error output.
  *
  * @param playerPosY The Y coordinate of the player's position.
  * @param playerPosX The X coordinate of the player's position.
  * @param playerHP The current health points of the player.
  * @param linepointer An integer representing the line pointer.
+ * @param encounterCount The number of monster encounters so far.
  */
-void storeStatus(int playerPosY, int playerPosX, int playerHP, int linepointer) {
+void storeStatus(int playerPosY, int playerPosX, int playerHP, int linepointer, int encounterCount) {
     ofstream statusfile(".gameConfig/status.txt");
     if (statusfile.fail()) {
         cerr << "Error opening status file" << endl;
         return;
     }
-    statusfile << playerPosY << " " << playerPosX << " " << playerHP << " " << linepointer;
+    statusfile << playerPosY << " " << playerPosX << " " << playerHP << " " << linepointer << " " << encounterCount;
     statusfile.close();
 }
 
 /**
  * @brief Creates an empty directory and files for game configuration.
  *
- * This function creates a directory named ".gameConfig" and three empty files within it:
- * - maze.txt
- * - minefield.txt
+ * This function creates a directory named ".gameConfig" and two empty files within it:
+ * - maze.bin
  * - status.txt
  *
+ * minefield.txt is only written when the player saves after a minesweeper game.
+ *
  * After creating the files, it opens the status.txt file and writes initial game status values:
  * - 0 (initial value)
  * - 1 (initial value)
  * - 5 (initial value)
  * - 0 (initial value)
+ * - 0 (initial value)
  *
  * If the status.txt file cannot be opened, an error message is printed to the standard error output.
  */
 void createEmptyFiles() {
     const int dir_err = mkdir(".gameConfig", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
-    std::ofstream file1(".gameConfig/maze.txt");
-    std::ofstream file2(".gameConfig/minefield.txt");
+    std::ofstream file1(".gameConfig/maze.bin");
     std::ofstream file3(".gameConfig/status.txt");
 
     file3.close();
@@ -234,11 +73,25 @@ void createEmptyFiles() {
         cerr << "Error opening status file" << endl;
         return;
     }
-    statusfile << 0 << " " << 1 << " " << 5 << " " << 0;
+    statusfile << 0 << " " << 1 << " " << 5 << " " << 0 << " " << 0;
     statusfile.close();
 
     file1.close();
-    file2.close();
+}
+
+/**
+ * @brief Runs one stage of the new-game pipeline and records its duration.
+ *
+ * @param timings The list of (stage name, milliseconds) pairs to append to.
+ * @param name The name of the stage.
+ * @param stage The work to run.
+ */
+template <typename Stage>
+void timeStage(vector<pair<string, double>> &timings, const string &name, Stage stage) {
+    auto begin = chrono::steady_clock::now();
+    stage();
+    auto end = chrono::steady_clock::now();
+    timings.emplace_back(name, chrono::duration<double, milli>(end - begin).count());
 }
 
 /**
@@ -249,10 +102,52 @@ void createEmptyFiles() {
  * updates the game state, and manages the game loop. The game involves navigating
  * a maze, avoiding monsters, and reaching the end to win.
  * 
+ * Command line options:
+ * - `--size N`: side length of a newly generated maze (default SIZE, at most MAX_SIZE, rounded up to odd).
+ * - `--profile-startup`: print how long each stage of new-game generation took and, at exit,
+ *   the median and 99th percentile time from an encounter to the first frame of its minefield.
+ * - `--export-text`: also write a new maze as text to .gameConfig/maze.txt.
+ * - `--seed N`: seed of a new game. The seed is stored in maze.bin, and the same seed
+ *   and size regenerate the same maze, monsters and minefields.
+ * - `--no-guess`: generate only minefields that can be cleared without guessing.
+ *
  * @return int Returns 0 on successful execution, 1 if there are errors in loading
  *         necessary game files.
  */
-int main() {
+int main(int argc, char *argv[]) {
+    int mazeSize = SIZE;
+    bool profileStartup = false;
+    bool exportText = false;
+    bool noGuess = false;
+    uint64_t seed = freshSeed();
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) {
+            mazeSize = atoi(argv[++i]);
+        } else if (arg == "--profile-startup") {
+            profileStartup = true;
+        } else if (arg == "--export-text") {
+            exportText = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--no-guess") {
+            noGuess = true;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--size N] [--seed N] [--no-guess] [--profile-startup] [--export-text]"
+                 << endl;
+            return 1;
+        }
+    }
+    if (mazeSize < 7) {
+        mazeSize = 7;
+    }
+    if (mazeSize > MAX_SIZE) {
+        mazeSize = MAX_SIZE;
+    }
+    if (mazeSize % 2 == 0) {
+        mazeSize++; // Prim's algorithm only carves odd cells, so the exit needs an odd size
+    }
+
     bool folderExists = false;
     struct stat st;
     if (stat(".gameConfig", &st) == 0) {
@@ -270,6 +165,12 @@ int main() {
     int playerPosY;
     int playerHP;
     int linepointer;
+    int encounterCount = 0;
+    int columnpointer = 0; // The first maze column on screen; follows the player, so it is not saved
+    vector<string> mazemap;
+    CorridorGraph corridors; // Built once with the maze and shared with the monsters
+    vector<pair<int, int>> monsterPositions;
+    vector<pair<int, int>> checkpointPositions;
     cout << "New game? ('n' for resume game) [y/n]: ";
     cin >> newGame;
     if (newGame == 'y') {
@@ -277,14 +178,39 @@ int main() {
         playerPosY = 0;
         playerHP = 5;
         linepointer = 0;
-        Maze maze_temp;
+        Maze maze_temp(mazeSize, mazeSize, seed);
         float monsterDensity = 0.5f;
-        maze_temp.generateMaze(maze_temp.startX, maze_temp.startY);
-        Cell *path = findPath();
-        maze_temp.placeCheckpoints();
-        maze_temp.placeMonsters(monsterDensity, path);
-        maze_temp.saveMaze();
-        deletePath(path);
+        // Every stage works on the in-memory grid; the file is only written at the end
+        vector<pair<string, double>> timings;
+        vector<PathNode> path;
+        timeStage(timings, "generate", [&]() { maze_temp.generateMaze(maze_temp.startX, maze_temp.startY); });
+        timeStage(timings, "solve", [&]() { path = maze_temp.solve(); });
+        timeStage(timings, "checkpoints", [&]() { maze_temp.placeCheckpoints(); });
+        timeStage(timings, "monsters", [&]() {
+            maze_temp.markPath(path);
+            maze_temp.placeMonsters(monsterDensity);
+        });
+        timeStage(timings, "save", [&]() { maze_temp.saveMaze(); });
+        if (exportText) {
+            maze_temp.exportText();
+        }
+        mazemap = maze_temp.toRows();
+        corridors = move(maze_temp.corridors);
+        for (const PathNode &monster : maze_temp.monsters) {
+            monsterPositions.emplace_back(monster.row, monster.col);
+        }
+        for (const PathNode &checkpoint : maze_temp.checkpoints) {
+            checkpointPositions.emplace_back(checkpoint.row, checkpoint.col);
+        }
+        if (profileStartup) {
+            double total = 0;
+            for (const auto &timing : timings) {
+                cout << timing.first << ": " << timing.second << " ms" << endl;
+                total += timing.second;
+            }
+            cout << "total: " << total << " ms" << endl;
+            cout << "seed: " << seed << endl;
+        }
     } else {
         ifstream statusFile(".gameConfig/status.txt");
         if (!statusFile) {
@@ -292,22 +218,49 @@ int main() {
             return 1;
         }
         statusFile >> playerPosY >> playerPosX >> playerHP >> linepointer;
+        if (!(statusFile >> encounterCount)) {
+            encounterCount = 0; // Saved before the encounter count was stored
+        }
         statusFile.close();
-    }
 
-    ifstream mazefile{".gameConfig/maze.txt"};
-    if (!mazefile) {
-        cerr << "Maze map not found!" << endl;
-        return 1;
+        // The binary maze is mapped as is; rows and positions are copied out without parsing
+        MappedMaze mazefile(".gameConfig/maze.bin");
+        if (!mazefile.isOpen()) {
+            cerr << "Maze map not found or corrupt!" << endl;
+            return 1;
+        }
+        seed = mazefile.seed(); // Monsters and minefields continue from the saved game's seed
+        mazemap.reserve(mazefile.height());
+        for (int y = 0; y < mazefile.height(); ++y) {
+            mazemap.emplace_back(mazefile.row(y), mazefile.width());
+        }
+        corridors = CorridorGraph(reinterpret_cast<const unsigned char *>(mazefile.cells()), mazefile.width(),
+                                  mazefile.height(), '#');
+        for (int i = 0; i < mazefile.monsterCount(); ++i) {
+            monsterPositions.emplace_back(mazefile.monsters()[i].row, mazefile.monsters()[i].col);
+        }
+        for (int i = 0; i < mazefile.checkpointCount(); ++i) {
+            checkpointPositions.emplace_back(mazefile.checkpoints()[i].row, mazefile.checkpoints()[i].col);
+        }
     }
 
-    srand(static_cast<unsigned>(time(nullptr)));
-
-    vector<string> mazemap;
-    string mazeStrip;
-    while (getline(mazefile, mazeStrip)) {
-        mazemap.push_back(mazeStrip);
+    // Monsters are tracked by the simulation and drawn from its snapshots, not from the map
+    for (const auto &monster : monsterPositions) {
+        mazemap[monster.first][monster.second] = ' ';
     }
+    GameSimulation sim(mazemap, corridors, monsterPositions, checkpointPositions, playerPosY, playerPosX, playerHP,
+                       deriveSeed(seed, SEED_STREAM_MONSTERS), MONSTER_TICK_MS, encounterCount);
+    WorldSnapshot world;
+    sim.takeSnapshot(world);
+    if (!sim.start()) {
+        cerr << "Unable to start the game simulation" << endl;
+        return 1;
+    }
+    // Minefields are generated ahead on their own thread; without it take() generates them on demand
+    MinefieldPool minefields(seed, noGuess, world.encounterCount + 1,
+                             encounterBoardSize(world.playerPosY, static_cast<int>(mazemap.size())));
+    minefields.start();
+    vector<double> encounterLatencies;
 
     int screenSizeY;
     int screenSizeX;
@@ -324,133 +277,126 @@ int main() {
     init_pair(8, COLOR_GREEN, COLOR_BLACK);
 
     char usrInput{};
+    MazeRenderer renderer;
+    int encountersHandled = world.encounterCount;
+    Board lastMinefield(0, 0); // The minefield of the latest encounter, written out only when the player saves
+
+    // This thread owns ncurses; it sleeps until a key arrives or the simulation publishes a snapshot
+    struct pollfd events[2] = {};
+    events[0].fd = STDIN_FILENO;
+    events[0].events = POLLIN;
+    events[1].fd = sim.notifyFd();
+    events[1].events = POLLIN;
+
+    bool redraw = true;
+    nodelay(stdscr, TRUE);
+    getmaxyx(stdscr, screenSizeY, screenSizeX);
 
-    vector<pair<int, int>> monsterPositions;
-    for (int y = 0; y < mazemap.size(); ++y) {
-        for (int x = 0; x < mazemap[y].size(); ++x) {
-            if (mazemap[y][x] == 'M') {
-                monsterPositions.emplace_back(y, x);
+    while (gameRunning) {
+        if (redraw) {
+            redraw = false;
+            getmaxyx(stdscr, screenSizeY, screenSizeX);
+            if (screenSizeX < 120) {
+                clear();
+                printw("Screen width of 120 required\n");
+                printw("Current width: %d\n", screenSizeX);
+                refresh();
+                renderer.invalidate();
+            } else {
+                // Scroll sideways so the player stays near the middle of the columns that fit
+                int mazeWidth = static_cast<int>(mazemap[0].size());
+                int viewColumns = MazeRenderer::visibleColumns(mazeWidth, screenSizeX);
+                columnpointer = max(0, min(world.playerPosX - viewColumns / 2, mazeWidth - viewColumns));
+                renderer.draw(mazemap, screenSizeY, screenSizeX, linepointer, columnpointer, world.playerPosY,
+                              world.playerPosX, world.monsterPositions, world.playerHP);
             }
         }
-    }
 
-    for (int i = 0; i < monsterPositions.size(); ++i) {
-        int y = monsterPositions[i].first;
-        int x = monsterPositions[i].second;
-        if (mazemap[max(0, y - 1)][x] == '#' || mazemap[min((int)mazemap.size() - 1, y + 1)][x] == '#') {
-            monsterDirections[i] = (rand() % 2 == 0) ? make_pair(0, -1) : make_pair(0, 1);
-        } else {
-            monsterDirections[i] = (rand() % 2 == 0) ? make_pair(-1, 0) : make_pair(1, 0);
+        if (poll(events, 2, -1) < 0) {
+            if (errno == EINTR) {
+                redraw = true; // Interrupted by a signal such as a terminal resize
+                continue;
+            }
+            break;
         }
-    }
 
-    vector<pair<int, int>> checkpointPositions;
-    for (int y = 0; y < mazemap.size(); ++y) {
-        for (int x = 0; x < mazemap[y].size(); ++x) {
-            if (mazemap[y][x] == 'C') {
-                checkpointPositions.emplace_back(y, x);
+        if (events[1].revents & POLLIN) {
+            uint64_t published;
+            if (read(sim.notifyFd(), &published, sizeof(published)) < 0) {
+                published = 0;
+            }
+            if (sim.takeSnapshot(world)) {
+                // Scroll the view so the player stays near the middle of the screen
+                while (world.playerPosY - linepointer < screenSizeY / 2 && linepointer > 0) {
+                    linepointer--;
+                }
+                while (world.playerPosY > screenSizeY / 2 + linepointer &&
+                       static_cast<size_t>(linepointer) + screenSizeY < mazemap.size()) {
+                    linepointer++;
+                }
+                minefields.expect(encounterBoardSize(world.playerPosY, static_cast<int>(mazemap.size())));
+                redraw = true;
             }
-        }
-    }
 
-    int msR;
-    bool msPause = false;
-    std::thread monsterThread([&]() {
-        while (gameRunning) {
-            if (!msPause && moveMonsters(mazemap, monsterPositions, make_pair(playerPosY, playerPosX))) {
-                msPause = true;
+            if (world.gameOver) {
+                refresh();
+                clear();
+                getmaxyx(stdscr, screenSizeY, screenSizeX);
+                int startX = (screenSizeX - 10) / 2;
+                int startY = screenSizeY / 2;
+                mvprintw(startY, startX, "Game over!");
+                refresh();
+                this_thread::sleep_for(std::chrono::seconds(2));
+                break;
+            }
+            if (world.win) {
+                win = true;
+                break;
+            }
+            if (world.encounter && world.encounterCount != encountersHandled) {
+                encountersHandled = world.encounterCount;
+                auto encounterBegin = chrono::steady_clock::now();
                 clear();
                 refresh();
-                msR = minesweeper();
-                if (msR != 0) {
-                    auto nearestCheckpoint = findNearestCheckpoint(
-                        checkpointPositions, playerPosY, playerPosX);
-                    playerPosY = nearestCheckpoint.first;
-                    playerPosX = nearestCheckpoint.second;
-                    playerHP--;
+                nodelay(stdscr, FALSE); // Minesweeper waits for each key
+                int boardSize = encounterBoardSize(world.playerPosY, static_cast<int>(mazemap.size()));
+                lastMinefield = minefields.take(world.encounterCount, boardSize);
+                chrono::steady_clock::time_point firstFrame;
+                int msR = minesweeper(lastMinefield, &firstFrame);
+                if (firstFrame != chrono::steady_clock::time_point()) {
+                    encounterLatencies.push_back(chrono::duration<double, milli>(firstFrame - encounterBegin).count());
                 }
+                nodelay(stdscr, TRUE);
                 std::this_thread::sleep_for(std::chrono::seconds(1));
-                if (playerHP <= 0) {
-                    refresh();
-                    clear();
-                    getmaxyx(stdscr, screenSizeY, screenSizeX);
-                    int startX = (screenSizeX - 10) / 2;
-                    int startY = screenSizeY / 2;
-                    mvprintw(startY, startX, "Game over!");
-                    refresh();
-                    this_thread::sleep_for(std::chrono::seconds(2));
-                    gameRunning = false;
-                    msPause = false;
-                    break;
-                }
-                msPause = false;
+                sim.post({CommandType::EncounterResult, msR});
                 clear();
                 refresh();
-                if (msR == 0) {
-                    std::this_thread::sleep_for(std::chrono::seconds(6));
-                }
+                renderer.invalidate();
+                flushinp(); // Drop keys typed while the result was shown
+                redraw = true;
+                continue;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
         }
-    });
 
-    nodelay(stdscr, TRUE);
-
-    do {
-        while (msPause) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-        move(0, 0);
-        getmaxyx(stdscr, screenSizeY, screenSizeX);
-        if (screenSizeX < 120) {
-            clear();
-            printw("Screen width of 120 required\n");
-            printw("Current width: %d\n", screenSizeX);
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            refresh();
-            continue;
-        }
-        switch (usrInput) {
-            case 'w':
-                if (playerPosY - linepointer < screenSizeY / 2 && linepointer > 0) {
-                    linepointer--;
-                }
-                if (playerPosY > 0 && mazemap[playerPosY - 1][playerPosX] != '#') {
-                    playerPosY--;
-                }
-                break;
-            case 's':
-                if (playerPosY > screenSizeY / 2 + linepointer &&
-                    linepointer + screenSizeY < mazemap.size()) {
-                    linepointer++;
-                }
-                if (mazemap[playerPosY + 1][playerPosX] != '#') {
-                    playerPosY++;
-                }
-                break;
-            case 'a':
-                if (mazemap[playerPosY][playerPosX - 1] != '#') {
-                    playerPosX--;
+        if (events[0].revents & POLLIN) {
+            int key;
+            while ((key = getch()) != ERR) {
+                usrInput = key;
+                if (usrInput == 'x' || usrInput == 'X') {
+                    gameRunning = false;
+                    break;
                 }
-                break;
-            case 'd':
-                if (mazemap[playerPosY][playerPosX + 1] != '#') {
-                    playerPosX++;
+                if (key == KEY_RESIZE) {
+                    redraw = true;
+                } else if (!sim.post({CommandType::Move, key})) {
+                    break; // The simulation is behind; drop the rest of this burst
                 }
-                break;
-        }
-        displayMap(mazemap, screenSizeY, linepointer, playerPosY, playerPosX, monsterPositions, playerHP);
-        refresh();
-        if (playerPosY + 1 >= mazemap.size()) {
-            win = true;
-            break;
-        }
-        usrInput = getch();
-        if (usrInput == ERR) {
-            continue;
+            }
         }
-    } while (usrInput != 'x' && usrInput != 'X' && gameRunning);
-    gameRunning = false;
+    }
+    // Apply whatever is still queued so the saved status matches the last screen
+    sim.stop();
+    sim.takeSnapshot(world);
     if (win) {
         getmaxyx(stdscr, screenSizeY, screenSizeX);
         clear();
@@ -461,10 +407,20 @@ int main() {
         this_thread::sleep_for(std::chrono::seconds(2));
     }
     if (usrInput == 'x' || usrInput == 'X') {
-        storeStatus(playerPosY, playerPosX, playerHP, linepointer);
+        storeStatus(world.playerPosY, world.playerPosX, world.playerHP, linepointer, world.encounterCount);
+        if (lastMinefield.size() > 0) {
+            saveMinefield(lastMinefield);
+        }
     }
 
-    monsterThread.join();
     endwin();
+    minefields.stop();
+    if (profileStartup && !encounterLatencies.empty()) {
+        sort(encounterLatencies.begin(), encounterLatencies.end());
+        size_t count = encounterLatencies.size();
+        cout << "encounter first frame: " << encounterLatencies[count / 2] << " ms p50, "
+             << encounterLatencies[min(count - 1, count * 99 / 100)] << " ms p99 over " << count << " encounters, "
+             << minefields.misses() << " minefields generated on demand" << endl;
+    }
     return 0;
 }
@@ -0,0 +1,65 @@
+#include "mazeFile.h"
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Maps a binary maze file into memory.
+ *
+ * The file is mapped read-only and the header is checked: the magic and
+ * version must match, the grid must not be empty, the file must be exactly
+ * as long as the header says and every checkpoint and monster must lie inside
+ * the grid. If any step fails, the object is left closed and isOpen() returns false.
+ *
+ * @param path The path of the binary maze file.
+ */
+MappedMaze::MappedMaze(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(MazeFileHeader))) {
+        close(fd);
+        return;
+    }
+    size = st.st_size;
+    data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (data == MAP_FAILED) {
+        data = nullptr;
+        return;
+    }
+
+    const MazeFileHeader *candidate = static_cast<const MazeFileHeader *>(data);
+    uint64_t expected = sizeof(MazeFileHeader) +
+                        (static_cast<uint64_t>(candidate->checkpointCount) + candidate->monsterCount) * sizeof(MazeFilePos) +
+                        static_cast<uint64_t>(candidate->width) * candidate->height;
+    if (memcmp(candidate->magic, MAZE_FILE_MAGIC, sizeof(candidate->magic)) != 0 ||
+        candidate->version != MAZE_FILE_VERSION || candidate->width == 0 || candidate->height == 0 ||
+        candidate->width > INT_MAX || candidate->height > INT_MAX || expected != size) {
+        return;
+    }
+    const MazeFilePos *saved = reinterpret_cast<const MazeFilePos *>(candidate + 1);
+    for (uint64_t i = 0; i < static_cast<uint64_t>(candidate->checkpointCount) + candidate->monsterCount; i++) {
+        if (saved[i].row >= candidate->height || saved[i].col >= candidate->width) {
+            return; // A corrupt or edited file; the game writes into the grid at these positions
+        }
+    }
+
+    header = candidate;
+    positions = reinterpret_cast<const MazeFilePos *>(header + 1);
+    grid = reinterpret_cast<const char *>(positions + header->checkpointCount + header->monsterCount);
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+MappedMaze::~MappedMaze() {
+    if (data != nullptr) {
+        munmap(data, size);
+    }
+}
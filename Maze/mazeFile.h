@@ -0,0 +1,96 @@
+#ifndef MAZEFILE_H
+#define MAZEFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define MAZE_FILE_MAGIC "MZB1"
+#define MAZE_FILE_VERSION 1
+
+/**
+ * @struct MazeFileHeader
+ * @brief The fixed-size header at the start of a binary maze file.
+ *
+ * A binary maze file is laid out as:
+ * 1. MazeFileHeader
+ * 2. checkpointCount MazeFilePos entries
+ * 3. monsterCount MazeFilePos entries
+ * 4. width * height bytes, one glyph ('#', ' ', 'C' or 'M') per cell, row-major
+ *
+ * All integers are stored in the byte order of the machine that wrote the file.
+ */
+struct MazeFileHeader {
+    char magic[4]; /**< Always MAZE_FILE_MAGIC */
+    uint32_t version; /**< Always MAZE_FILE_VERSION */
+    uint32_t width; /**< The number of columns of the maze */
+    uint32_t height; /**< The number of rows of the maze */
+    uint64_t seed; /**< The seed the maze was generated from */
+    uint32_t checkpointCount; /**< The number of checkpoint positions that follow the header */
+    uint32_t monsterCount; /**< The number of monster positions that follow the checkpoints */
+};
+
+/**
+ * @struct MazeFilePos
+ * @brief A cell position stored in a binary maze file.
+ */
+struct MazeFilePos {
+    uint32_t row; /**< The row (y-coordinate) of the cell */
+    uint32_t col; /**< The column (x-coordinate) of the cell */
+};
+
+/**
+ * @class MappedMaze
+ * @brief A read-only view of a binary maze file mapped into memory with mmap.
+ *
+ * Nothing is parsed or copied: the accessors point straight into the mapping,
+ * which stays valid until the object is destroyed.
+ */
+class MappedMaze {
+public:
+    /**
+     * @brief Maps the given file and validates its header, size and positions.
+     * @param path The path of the binary maze file
+     */
+    explicit MappedMaze(const std::string &path);
+    ~MappedMaze();
+
+    MappedMaze(const MappedMaze &) = delete;
+    MappedMaze &operator=(const MappedMaze &) = delete;
+
+    /**
+     * @brief Checks if the file was mapped and is a valid binary maze.
+     * @return True if the accessors may be used, false otherwise
+     */
+    bool isOpen() const { return header != nullptr; }
+
+    int width() const { return header->width; }
+    int height() const { return header->height; }
+    uint64_t seed() const { return header->seed; }
+    int checkpointCount() const { return header->checkpointCount; }
+    int monsterCount() const { return header->monsterCount; }
+    const MazeFilePos *checkpoints() const { return positions; }
+    const MazeFilePos *monsters() const { return positions + header->checkpointCount; }
+
+    /**
+     * @brief Returns the glyphs of one row of the maze (not null-terminated).
+     * @param y The row to return
+     * @return A pointer to width() glyphs
+     */
+    const char *row(int y) const { return grid + static_cast<size_t>(y) * header->width; }
+
+    /**
+     * @brief Returns the glyphs of the whole maze, row-major (not null-terminated).
+     * @return A pointer to width() * height() glyphs
+     */
+    const char *cells() const { return grid; }
+
+private:
+    void *data = nullptr; /**< The start of the mapping */
+    size_t size = 0; /**< The length of the mapping in bytes */
+    const MazeFileHeader *header = nullptr;
+    const MazeFilePos *positions = nullptr;
+    const char *grid = nullptr;
+};
+
+#endif
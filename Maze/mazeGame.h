@@ -7,11 +7,28 @@
 #include <ctime>
 #include <algorithm>
 #include <fstream>
+#include <string>
 #include "DFS.h"
+#include "pathfinder.h"
+#include "corridorGraph.h"
+#include "gameRandom.h"
 
-#define SIZE 55 // Update the size of the maze here (default: 55)
+#define SIZE 55 // Default size of the maze, can be overridden with --size at runtime
+#define MAX_SIZE 4095 // Largest maze side accepted by --size; wider mazes scroll sideways on screen
 #define WALL 1
 #define PATH 0
+#define MONSTER_SPACING 5 // No two monsters are placed within this Chebyshev distance of each other
+
+/**
+ * @struct Frontier
+ * @brief A candidate cell for Prim's algorithm together with the carved cell it was discovered from.
+ */
+struct Frontier {
+    int fromX; /**< The x-coordinate of the carved cell next to the frontier */
+    int fromY; /**< The y-coordinate of the carved cell next to the frontier */
+    int x; /**< The x-coordinate of the frontier cell */
+    int y; /**< The y-coordinate of the frontier cell */
+};
 
 /**
  * @class Maze
@@ -19,40 +36,63 @@
  */
 class Maze {
 public:
+    int width; /**< The number of columns of the maze */
+    int height; /**< The number of rows of the maze */
     int startX; /**< The x-coordinate of the starting point of the maze */
     int startY; /**< The y-coordinate of the starting point of the maze */
-    int maze[SIZE][SIZE]; /**< The maze grid */
-    bool noMonsterZone[SIZE][SIZE] = {false};
-    std::vector<std::vector<int>> directions = { {0, -2}, {2, 0}, {0, 2}, {-2, 0} }; /**< The possible directions to move in the maze */
-    std::vector<std::vector<int>> potentialFrontier; /**< The list of potential frontier cells */
+    std::vector<unsigned char> maze; /**< The maze grid, row-major with 1 byte per cell */
+    std::vector<bool> noMonsterZone; /**< Cells where monsters may not be placed, row-major */
+    std::vector<bool> pathMask; /**< Cells on the solution path, row-major */
+    std::vector<bool> monsterBlocked; /**< Cells too close to an already placed monster, row-major */
+    std::vector<PathNode> checkpoints; /**< The checkpoints placed by placeCheckpoints() */
+    std::vector<PathNode> monsters; /**< The monsters placed by placeMonsters() */
+    static constexpr int directions[4][2] = { {0, -2}, {2, 0}, {0, 2}, {-2, 0} }; /**< The possible directions to move in the maze */
+    std::vector<Frontier> potentialFrontier; /**< The list of potential frontier cells */
+    CorridorGraph corridors; /**< Junctions, dead ends and corridors, rebuilt by generateMaze() */
+    uint64_t seed; /**< The seed of rng, recorded in the save so the maze can be regenerated */
+    GameRng rng; /**< The one engine behind every random choice of generation and placement */
 
     /**
      * @brief Constructs a Maze object and initializes all cells in the maze to be walls.
+     * @param width The number of columns of the maze (should be odd)
+     * @param height The number of rows of the maze (should be odd)
+     * @param seed The seed of the generation pipeline; the same seed and size give the same maze
      */
-    Maze();
+    Maze(int width = SIZE, int height = SIZE, uint64_t seed = freshSeed());
 
     /**
-     * @brief Checks if a cell is a duplicate in the list of potential frontiers.
-     * @param x The x-coordinate of the cell
-     * @param y The y-coordinate of the cell
-     * @return True if the cell is not a duplicate, false otherwise
+     * @brief Accesses the cell at the given coordinates.
+     * @param x The x-coordinate (column) of the cell
+     * @param y The y-coordinate (row) of the cell
+     * @return A reference to the cell
      */
-    bool checkDuplicate(int x, int y);
+    unsigned char &cell(int x, int y) { return maze[static_cast<size_t>(y) * width + x]; }
+    unsigned char cell(int x, int y) const { return maze[static_cast<size_t>(y) * width + x]; }
 
     /**
-     * @brief Generates the maze using recursive randomized Prim's Algorithm.
-     * @param x The x-coordinate of the current cell
-     * @param y The y-coordinate of the current cell
+     * @brief Generates the maze using iterative randomized Prim's Algorithm.
+     * @param x The x-coordinate of the starting cell
+     * @param y The y-coordinate of the starting cell
      * @brief Steps:
      * 1. Select (x, y) to be the starting point
-     * 2. Find all possible frontiers
-     * 3. Randomly select a frontier
-     * 4. Carve a path to the frontier
-     * 5. Repeat steps 2-4 until there are no more frontiers
+     * 2. Add its unvisited neighbours to the frontier
+     * 3. Randomly select a frontier and remove it with swap-and-pop
+     * 4. If the frontier is still unvisited, carve a path to it and add its neighbours
+     * 5. Repeat steps 3-4 until there are no more frontiers
+     * 6. Open the entrance (1, 0) and the exit (width - 2, height - 1)
+     * 7. Compress the corridors into the junction graph `corridors`
+     * A visited bitmap replaces duplicate scanning, so each step is O(1) and no recursion is needed.
      * More info at https://en.wikipedia.org/wiki/Maze_generation_algorithm#Iterative_randomized_Prim's_algorithm_(without_stack,_without_sets)
      */
     void generateMaze(int x, int y);
 
+    /**
+     * @brief Finds the shortest path from the entrance to the exit of the in-memory grid.
+     * @param algorithm The search strategy to use; Corridor reuses the graph built by generateMaze()
+     * @return The path from the entrance to the exit, or an empty vector if there is none
+     */
+    std::vector<PathNode> solve(PathAlgorithm algorithm = PathAlgorithm::BFS) const;
+
     /**
      * @brief Marks a 5x5 area as a no monster zone in the maze.
      *
@@ -66,10 +106,16 @@ public:
     void markNoMonsterZone(int cx, int cy);
 
     /**
-     * @brief Places monsters in dead ends near the entrance of the maze.
+     * @brief Places monsters in dead ends that are not on the path recorded in pathMask.
      * @param density The density of monsters to be placed (0.0 to 1.0).
      */
-    void placeMonsters(float density, Cell* path);
+    void placeMonsters(float density);
+
+    /**
+     * @brief Records the solution path in pathMask, replacing any previous path.
+     * @param path The path as returned by solveMaze()
+     */
+    void markPath(const std::vector<PathNode>& path);
 
     /**
      * @brief Checks if the cell at the given coordinates is a dead end.
@@ -77,7 +123,7 @@ public:
      * @param y The y-coordinate of the cell
      * @return True if the cell is a dead end, false otherwise
      */
-    bool isDeadEnd(int x, int y);
+    bool isDeadEnd(int x, int y) const;
 
     /**
      * @brief Places checkpoints in the maze.
@@ -91,24 +137,23 @@ public:
      *
      * The six positions for the checkpoints are defined as follows:
      * - Top-left: (offsetX, offsetY)
-     * - Top-right: (SIZE - offsetX - 1, offsetY)
+     * - Top-right: (width - offsetX - 1, offsetY)
      * - Middle-left: (offsetX, middleY)
-     * - Middle-right: (SIZE - offsetX - 1, middleY)
-     * - Bottom-left: (offsetX, SIZE - offsetY - 1)
-     * - Bottom-right: (SIZE - offsetX - 1, SIZE - offsetY - 1)
+     * - Middle-right: (width - offsetX - 1, middleY)
+     * - Bottom-left: (offsetX, height - offsetY - 1)
+     * - Bottom-right: (width - offsetX - 1, height - offsetY - 1)
      *
      * The offsets and middle coordinates are calculated based on the size of the maze.
      */
     void placeCheckpoints();
 
     /**
-     * @brief Checks if the cell at the given coordinates is on the path.
+     * @brief Checks if the cell at the given coordinates is on the path recorded by markPath().
      * @param x The x-coordinate of the cell
      * @param y The y-coordinate of the cell
-     * @param path The path to check against
      * @return True if the cell is on the path, false otherwise
      */
-    bool isOnPath(int x, int y, Cell* path);
+    bool isOnPath(int x, int y) const { return pathMask[static_cast<size_t>(y) * width + x]; }
 
     /**
      * @brief Checks if the cell at the given coordinates is near another monster.
@@ -116,7 +161,28 @@ public:
      * @param y The y-coordinate of the cell
      * @return True if the cell is near another monster, false otherwise
      */
-    bool isNearOtherMonster(int x, int y);
+    bool isNearOtherMonster(int x, int y) const;
+
+    /**
+     * @brief Marks the cells within MONSTER_SPACING of a placed monster as blocked.
+     * @param x The x-coordinate of the monster
+     * @param y The y-coordinate of the monster
+     */
+    void markMonsterSpacing(int x, int y);
+
+    /**
+     * @brief Returns the character used for a cell in the saved maze ('#', ' ', 'C' or 'M').
+     * @param x The x-coordinate of the cell
+     * @param y The y-coordinate of the cell
+     * @return The character for the cell
+     */
+    char glyph(int x, int y) const;
+
+    /**
+     * @brief Converts the maze into rows of glyph() characters, the same layout as the saved maze.
+     * @return The rows of the maze from top to bottom
+     */
+    std::vector<std::string> toRows() const;
 
     /**
      * @brief Prints the maze.
@@ -124,9 +190,16 @@ public:
     void printMaze();
 
     /**
-     * @brief Saves the maze to a file.
+     * @brief Saves the maze to a binary file that can be loaded with MappedMaze.
+     * @param path The path of the file to write
+     */
+    void saveMaze(const std::string& path = ".gameConfig/maze.bin") const;
+
+    /**
+     * @brief Exports the maze as text, one row per line.
+     * @param path The path of the file to write
      */
-    void saveMaze();
+    void exportText(const std::string& path = ".gameConfig/maze.txt") const;
 };
 
 #endif
\ No newline at end of file
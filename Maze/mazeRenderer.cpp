@@ -0,0 +1,102 @@
+#include "mazeRenderer.h"
+#include <algorithm>
+#include <ncurses.h>
+
+using namespace std;
+
+/**
+ * @brief Draws one frame of the maze screen.
+ *
+ * Only the rows from linepointer to linepointer + screenSizeY, and in them the
+ * visibleColumns() columns from columnpointer on, are read from the maze. Monsters and the player are overlaid on that window, then the frame is
+ * compared cell by cell with the previous one. Consecutive changed cells with the
+ * same colour pair are sent as one addnstr() call with a single attron()/attroff()
+ * pair. The HP counter is redrawn every frame to the right of the maze, in the
+ * HP_COLUMNS columns kept free for it.
+ *
+ * @param mazemap The maze, one string per row.
+ * @param screenSizeY The height of the screen in lines.
+ * @param screenSizeX The width of the screen in columns.
+ * @param linepointer The first maze row shown at the top of the screen.
+ * @param columnpointer The first maze column shown at the left of the screen.
+ * @param playerPosY The row of the player.
+ * @param playerPosX The column of the player.
+ * @param monsterPositions The (row, column) positions of the monsters.
+ * @param playerHP The current health points of the player.
+ */
+void MazeRenderer::draw(const vector<string> &mazemap, int screenSizeY, int screenSizeX, int linepointer,
+                        int columnpointer, int playerPosY, int playerPosX, const vector<pair<int, int>> &monsterPositions, int playerHP) {
+    int mazeWidth = mazemap.empty() ? 0 : mazemap[0].size();
+    int newRows = max(0, screenSizeY);
+    int newCols = max(0, visibleColumns(mazeWidth, screenSizeX));
+    columnpointer = max(0, min(columnpointer, mazeWidth - newCols));
+    if (newRows != rows || newCols != cols) {
+        rows = newRows;
+        cols = newCols;
+        fullRedraw = true;
+    }
+    if (fullRedraw.exchange(false)) {
+        // Nothing on screen can be trusted, so compare against a frame that matches no glyph
+        front.assign(static_cast<size_t>(rows) * cols, Glyph{'\0', -1});
+    }
+
+    // Compose the visible window
+    const Glyph blank = {' ', 0};
+    back.assign(static_cast<size_t>(rows) * cols, blank);
+    int visibleRows = min(rows, static_cast<int>(mazemap.size()) - linepointer);
+    for (int r = 0; r < visibleRows; r++) {
+        const string &mazeStrip = mazemap[linepointer + r];
+        Glyph *line = &back[static_cast<size_t>(r) * cols];
+        for (int c = 0; c < cols; c++) {
+            char ch = mazeStrip[columnpointer + c];
+            if (ch == 'C') {
+                line[c] = Glyph{'C', 2};
+            } else if (ch == 'M') {
+                line[c] = Glyph{'M', 8};
+            } else if (ch == '#') {
+                line[c] = Glyph{'#', 0};
+            }
+        }
+    }
+    auto overlay = [&](int y, int x, Glyph glyph) {
+        if (y >= linepointer && y < linepointer + visibleRows && x >= columnpointer && x < columnpointer + cols) {
+            back[static_cast<size_t>(y - linepointer) * cols + x - columnpointer] = glyph;
+        }
+    };
+    for (const auto &monsterPos : monsterPositions) {
+        overlay(monsterPos.first, monsterPos.second, Glyph{'M', 8});
+    }
+    overlay(playerPosY, playerPosX, Glyph{'P', 2});
+
+    // Emit only the runs of cells that differ from the previous frame
+    for (int r = 0; r < rows; r++) {
+        const Glyph *now = &back[static_cast<size_t>(r) * cols];
+        const Glyph *before = &front[static_cast<size_t>(r) * cols];
+        int c = 0;
+        while (c < cols) {
+            if (now[c] == before[c]) {
+                c++;
+                continue;
+            }
+            int start = c;
+            short colorPair = now[c].colorPair;
+            run.clear();
+            while (c < cols && now[c] != before[c] && now[c].colorPair == colorPair) {
+                run += now[c].ch;
+                run += now[c].ch == '#' ? '#' : ' ';
+                c++;
+            }
+            if (colorPair != 0) {
+                attron(COLOR_PAIR(colorPair));
+            }
+            mvaddnstr(r, start * 2, run.data(), run.size());
+            if (colorPair != 0) {
+                attroff(COLOR_PAIR(colorPair));
+            }
+        }
+    }
+    front.swap(back);
+
+    mvprintw(screenSizeY / 2, cols * 2 + 5, "HP: %d", playerHP);
+    refresh();
+}
@@ -0,0 +1,77 @@
+#ifndef MAZERENDERER_H
+#define MAZERENDERER_H
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define HP_COLUMNS 10 // Screen columns kept free to the right of the maze for the HP counter
+
+/**
+ * @class MazeRenderer
+ * @brief Draws the visible window of the maze with ncurses, emitting only the cells that changed.
+ *
+ * Each maze cell takes two screen columns. The renderer keeps the previous frame
+ * as a back buffer; every draw composes the new frame for the rows in the viewport
+ * only, compares it with the old one and writes each run of changed cells that
+ * share a colour pair with a single addnstr() call. The work per frame therefore
+ * depends on the screen size, not on the size of the maze.
+ */
+class MazeRenderer {
+public:
+    /**
+     * @brief Draws one frame.
+     * @param mazemap The maze, one string per row
+     * @param screenSizeY The height of the screen in lines
+     * @param screenSizeX The width of the screen in columns
+     * @param linepointer The first maze row shown at the top of the screen
+     * @param columnpointer The first maze column shown at the left of the screen
+     * @param playerPosY The row of the player
+     * @param playerPosX The column of the player
+     * @param monsterPositions The (row, column) positions of the monsters
+     * @param playerHP The current health points of the player
+     */
+    void draw(const std::vector<std::string> &mazemap, int screenSizeY, int screenSizeX, int linepointer,
+              int columnpointer, int playerPosY, int playerPosX, const std::vector<std::pair<int, int>> &monsterPositions, int playerHP);
+
+    /**
+     * @brief Returns how many maze columns fit on the screen next to the HP counter.
+     * @param mazeWidth The number of columns of the maze
+     * @param screenSizeX The width of the screen in columns
+     * @return The number of maze columns drawn per row
+     */
+    static int visibleColumns(int mazeWidth, int screenSizeX) {
+        return mazeWidth < (screenSizeX - HP_COLUMNS) / 2 ? mazeWidth : (screenSizeX - HP_COLUMNS) / 2;
+    }
+
+    /**
+     * @brief Forgets the previous frame so that the next draw repaints every cell.
+     *
+     * Call this whenever something else has drawn over or cleared the screen.
+     * It may be called from any thread.
+     */
+    void invalidate() { fullRedraw = true; }
+
+private:
+    /**
+     * @struct Glyph
+     * @brief One maze cell as shown on screen.
+     */
+    struct Glyph {
+        char ch; /**< The maze character ('#', ' ', 'P', 'M' or 'C') */
+        short colorPair; /**< The ncurses colour pair, 0 for the default colours */
+
+        bool operator==(const Glyph &other) const { return ch == other.ch && colorPair == other.colorPair; }
+        bool operator!=(const Glyph &other) const { return !(*this == other); }
+    };
+
+    std::vector<Glyph> front; /**< The frame currently on screen */
+    std::vector<Glyph> back; /**< The frame being composed */
+    std::string run; /**< Scratch buffer for one run of changed cells */
+    int rows = 0; /**< The number of rows of the buffers */
+    int cols = 0; /**< The number of maze columns of the buffers */
+    std::atomic<bool> fullRedraw{true}; /**< Set when the screen no longer matches front */
+};
+
+#endif
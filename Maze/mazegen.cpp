@@ -0,0 +1,111 @@
+#include "mazeGame.h"
+#include "threadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+
+using namespace std;
+
+/**
+ * @brief Runs the new-game pipeline of the game on one maze.
+ *
+ * The stages run in the same order as in main(), so a maze built here from a
+ * seed is identical to the one `mazeGame --seed` builds from that seed.
+ *
+ * @param maze The maze to fill in.
+ * @param monsterDensity The density passed to placeMonsters().
+ * @return true if the exit can be reached from the entrance.
+ */
+bool buildMaze(Maze &maze, float monsterDensity) {
+    maze.generateMaze(maze.startX, maze.startY);
+    vector<PathNode> path = maze.solve();
+    maze.placeCheckpoints();
+    maze.markPath(path);
+    maze.placeMonsters(monsterDensity);
+    return !path.empty();
+}
+
+/**
+ * @brief Entry point of the headless maze generator.
+ *
+ * Usage: mazegen [--count N] [--size N] [--seed N] [--threads N] [--format bin|text] [--out DIR]
+ *
+ * Generates `count` mazes in parallel, each with its own engine seeded with
+ * seed + index, runs the solver, checkpoint and monster passes on each and
+ * writes them to DIR/maze_<index>.bin (or .txt). Afterwards the throughput is
+ * printed in mazes and cells per second.
+ *
+ * @return int Returns 0 on success, 1 on bad arguments.
+ */
+int main(int argc, char *argv[]) {
+    int count = 16;
+    int size = SIZE;
+    uint64_t seed = freshSeed();
+    int threads = defaultThreadCount();
+    string format = "bin";
+    string outDir = "mazes";
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--count" && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (arg == "--size" && i + 1 < argc) {
+            size = atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--format" && i + 1 < argc) {
+            format = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0]
+                 << " [--count N] [--size N] [--seed N] [--threads N] [--format bin|text] [--out DIR]" << endl;
+            return 1;
+        }
+    }
+    if (count < 1 || (format != "bin" && format != "text")) {
+        cerr << "mazegen: --count must be positive and --format bin or text" << endl;
+        return 1;
+    }
+    if (threads < 1) {
+        threads = defaultThreadCount();
+    }
+    if (size < 7) {
+        size = 7;
+    }
+    if (size % 2 == 0) {
+        size++; // Prim's algorithm only carves odd cells, so the exit needs an odd size
+    }
+    mkdir(outDir.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+
+    atomic<int> failed{0};
+    auto begin = chrono::steady_clock::now();
+    parallelFor(count, threads, [&](int index, int) {
+        Maze maze(size, size, seed + index);
+        if (!buildMaze(maze, 0.5f)) {
+            failed++;
+        }
+        string path = outDir + "/maze_" + to_string(index) + (format == "bin" ? ".bin" : ".txt");
+        if (format == "bin") {
+            maze.saveMaze(path);
+        } else {
+            maze.exportText(path);
+        }
+    });
+    auto end = chrono::steady_clock::now();
+
+    double seconds = chrono::duration<double>(end - begin).count();
+    double cells = static_cast<double>(size) * size * count;
+    cout << "mazegen: " << count << " mazes of " << size << "x" << size << " on " << min(threads, count)
+         << " threads in " << seconds * 1000 << " ms" << endl;
+    cout << count / seconds << " mazes/s, " << cells / seconds << " cells/s" << endl;
+    cout << "seeds " << seed << " to " << seed + count - 1 << ", written to " << outDir << "/" << endl;
+    if (failed > 0) {
+        cerr << "mazegen: " << failed << " mazes had no path from the entrance to the exit" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -4,7 +4,9 @@
 #include <ctime>
 #include <algorithm>
 #include <fstream>
+#include <cstring>
 #include "mazeGame.h"
+#include "mazeFile.h"
 #include "DFS.h"
 
 using namespace std;
@@ -12,88 +14,101 @@ using namespace std;
 /**
  * @brief Constructs a Maze object and initializes the maze grid.
  * 
- * This constructor initializes the maze grid to be completely filled with walls.
- * It also sets the starting coordinates of the maze to (1, 1).
+ * This constructor allocates a contiguous, row-major grid of width x height
+ * bytes on the heap and fills it with walls.
+ * It also sets the starting coordinates of the maze to (1, 1) and seeds the
+ * random engine shared by generateMaze() and placeMonsters().
+ *
+ * @param width The number of columns of the maze (should be odd).
+ * @param height The number of rows of the maze (should be odd).
+ * @param seed The seed of the random engine.
  */
-Maze::Maze() : startX(1), startY(1) {
-    for (int y = 0; y < SIZE; y++) {
-        for (int x = 0; x < SIZE; x++) {
-            maze[y][x] = WALL;
-        }
-    }
-}
+Maze::Maze(int width, int height, uint64_t seed)
+    : width(width), height(height), startX(1), startY(1),
+      maze(static_cast<size_t>(width) * height, WALL),
+      noMonsterZone(static_cast<size_t>(width) * height, false),
+      pathMask(static_cast<size_t>(width) * height, false),
+      monsterBlocked(static_cast<size_t>(width) * height, false), seed(seed), rng(seed) {}
 
-/**
- * @brief Checks if a given coordinate (x, y) is a duplicate in the potentialFrontier list.
- * 
- * This function iterates through the potentialFrontier list and checks if any of the 
- * elements have the same x and y coordinates as the provided (x, y). If a match is found, 
- * it returns false indicating that the coordinate is a duplicate. If no match is found, 
- * it returns true indicating that the coordinate is unique.
- * 
- * @param x The x-coordinate to check.
- * @param y The y-coordinate to check.
- * @return true if the coordinate (x, y) is unique in the potentialFrontier list.
- * @return false if the coordinate (x, y) is a duplicate in the potentialFrontier list.
- */
-bool Maze::checkDuplicate(int x, int y) {
-    for (const auto& vec : potentialFrontier) {
-        if (vec[2] == x && vec[3] == y) {
-            return false;
-        }
-    }
-    return true;
-}
+constexpr int Maze::directions[4][2];
 
 /**
- * @brief Generates the maze using recursive randomized Prim's Algorithm.
- * @param x The x-coordinate of the current cell
- * @param y The y-coordinate of the current cell
+ * @brief Generates the maze using iterative randomized Prim's Algorithm.
+ * @param x The x-coordinate of the starting cell
+ * @param y The y-coordinate of the starting cell
  * @brief Steps:
  * 1. Select (x, y) to be the starting point
- * 2. Find all possible frontiers
- * 3. Randomly select a frontier
- * 4. Carve a path to the frontier
- * 5. Repeat steps 2-4 until there are no more frontiers
+ * 2. Add its unvisited neighbours to the frontier
+ * 3. Randomly select a frontier and remove it with swap-and-pop
+ * 4. If the frontier is still unvisited, carve a path to it and add its neighbours
+ * 5. Repeat steps 3-4 until there are no more frontiers
+ *
+ * The same cell may be pushed once per carved neighbour; the visited bitmap
+ * discards the stale copies when they are popped, so no duplicate scan is needed.
+ * Finally the entrance (1, 0) and the exit (width - 2, height - 1) are opened,
+ * so the grid can be solved in memory exactly as it is saved, and the corridors
+ * are compressed into the junction graph used by solve(), isDeadEnd() and placeMonsters().
  * More info at https://en.wikipedia.org/wiki/Maze_generation_algorithm#Iterative_randomized_Prim's_algorithm_(without_stack,_without_sets)
  */
 void Maze::generateMaze(int x, int y) {
-    // Initialize random number generator
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::vector<bool> visited(maze.size(), false);
+    potentialFrontier.clear();
 
-    // Selected (x, y) to be the starting point (step 1)
-    maze[x][y] = PATH;
-
-    // Find all possible frontiers (step 2)
-    for (const auto& direction : directions) {
-        int nextX = x + direction[0];
-        int nextY = y + direction[1];
-        if (nextX > 0 && nextX < SIZE && nextY > 0 && nextY < SIZE && maze[nextX][nextY] == WALL && checkDuplicate(nextX, nextY)) {
-            potentialFrontier.push_back({x, y, nextX, nextY});
+    // Adds every unvisited cell two steps away from (cx, cy) to the frontier
+    auto addFrontiers = [this, &visited](int cx, int cy) {
+        for (const auto& direction : directions) {
+            int nextX = cx + direction[0];
+            int nextY = cy + direction[1];
+            if (nextX > 0 && nextX < width && nextY > 0 && nextY < height && !visited[nextY * width + nextX]) {
+                potentialFrontier.push_back({cx, cy, nextX, nextY});
+            }
         }
-    }
+    };
 
-    // Remove duplicates
-    sort(potentialFrontier.begin(), potentialFrontier.end());
-    potentialFrontier.erase(unique(potentialFrontier.begin(), potentialFrontier.end()), potentialFrontier.end());
+    // Selected (x, y) to be the starting point (step 1)
+    cell(x, y) = PATH;
+    visited[y * width + x] = true;
+    addFrontiers(x, y); // Step 2
 
-    // Step 3 to 6
+    // Step 3 to 5
     while (!potentialFrontier.empty()) {
-        std::uniform_int_distribution<> dis(0, potentialFrontier.size() - 1);
-        int randomIndex = dis(gen);
-        auto randomFrontier = potentialFrontier[randomIndex];
-        potentialFrontier.erase(potentialFrontier.begin() + randomIndex);
-        int frontierX = randomFrontier[2];
-        int frontierY = randomFrontier[3];
-        int wallX = (frontierX + randomFrontier[0]) / 2;
-        int wallY = (frontierY + randomFrontier[1]) / 2;
-        if (maze[wallX][wallY] == WALL) {
-            maze[wallX][wallY] = PATH;
-            maze[frontierX][frontierY] = PATH;
-            generateMaze(frontierX, frontierY);
+        size_t randomIndex = randomBelow(rng, potentialFrontier.size());
+        Frontier frontier = potentialFrontier[randomIndex];
+        potentialFrontier[randomIndex] = potentialFrontier.back();
+        potentialFrontier.pop_back();
+
+        if (visited[frontier.y * width + frontier.x]) {
+            continue;
         }
+        visited[frontier.y * width + frontier.x] = true;
+        cell((frontier.x + frontier.fromX) / 2, (frontier.y + frontier.fromY) / 2) = PATH;
+        cell(frontier.x, frontier.y) = PATH;
+        addFrontiers(frontier.x, frontier.y);
+    }
+
+    cell(1, 0) = PATH;
+    cell(width - 2, height - 1) = PATH;
+
+    corridors = CorridorGraph(maze.data(), width, height, WALL);
+}
+
+/**
+ * @brief Finds the shortest path from the entrance to the exit of the in-memory maze.
+ *
+ * The grid is handed to solveMaze() directly, so no file needs to be written or read.
+ * Corridor searches the junction graph built by generateMaze() instead of rebuilding it;
+ * the entrance and the exit are dead ends, so they are always nodes.
+ *
+ * @param algorithm The search strategy to use.
+ * @return The cells from the entrance (row 0) to the exit (last row), or an empty vector if there is no path.
+ */
+std::vector<PathNode> Maze::solve(PathAlgorithm algorithm) const {
+    PathNode entrance = {0, 1};
+    PathNode exit = {height - 1, width - 2};
+    if (algorithm == PathAlgorithm::Corridor) {
+        return corridors.shortestPath(entrance, exit);
     }
+    return solveMaze(maze.data(), width, height, WALL, entrance, exit, algorithm);
 }
 
 /**
@@ -111,8 +126,8 @@ void Maze::markNoMonsterZone(int cx, int cy) {
         for (int dy = -3; dy <= 3; ++dy) {
             int nx = cx + dx;
             int ny = cy + dy;
-            if (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE) {
-                noMonsterZone[ny][nx] = true;
+            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
+                noMonsterZone[ny * width + nx] = true;
             }
         }
     }
@@ -120,91 +135,97 @@ void Maze::markNoMonsterZone(int cx, int cy) {
 
 /**
  * @brief Places monsters in the maze based on the given density.
- * 
- * This function identifies potential positions for monsters within the maze,
- * ensuring that they are placed on dead-end paths and not in restricted zones.
- * The number of monsters is determined by the density parameter, and their
- * positions are randomly selected from the potential positions.
- * 
+ *
+ * Candidates are taken from the dead ends of the corridor graph, so only those
+ * cells are visited rather than the whole grid. The path check is a lookup in
+ * pathMask, so this does not depend on how long the solution path is.
+ *
+ * The candidates are then shuffled and accepted one by one. Spacing is enforced
+ * during this selection: each accepted monster blocks the window around it in
+ * monsterBlocked, so a later candidate inside that window is skipped with a
+ * single lookup. Blocked windows of accepted monsters never share a centre, so
+ * the total marking work is bounded by a constant times the number of cells.
+ *
  * @param density A float value representing the density of monsters to be placed.
- *                This value should be between 0 and 1, where 0 means no monsters
- *                and 1 means maximum possible monsters based on potential positions.
- * @param path A pointer to the Cell structure representing the path in the maze.
- *             This is used to ensure monsters are not placed on the main path.
  */
-void Maze::placeMonsters(float density, Cell* path) {
+void Maze::placeMonsters(float density) {
     std::vector<std::pair<int, int>> potentialMonsterPositions;
-    for (int y = 1; y < SIZE - 1; y++) {
-        for (int x = 1; x < SIZE - 1; x++) {
-            if (maze[y][x] == PATH && isDeadEnd(x, y) && !noMonsterZone[y][x] && !isOnPath(x, y, path) && !isNearOtherMonster(x, y)) {
-                potentialMonsterPositions.push_back({x, y});
-            }
+    for (int node : corridors.deadEnds()) {
+        int x = corridors.nodeCell(node).col;
+        int y = corridors.nodeCell(node).row;
+        if (y > 0 && y < height - 1 && cell(x, y) == PATH && !noMonsterZone[y * width + x] && !isOnPath(x, y)) {
+            potentialMonsterPositions.push_back({x, y});
         }
     }
 
     int numMonsters = density * potentialMonsterPositions.size();
 
-    // Use std::shuffle with a random number generator
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(potentialMonsterPositions.begin(), potentialMonsterPositions.end(), g);
+    shuffleRange(potentialMonsterPositions.begin(), potentialMonsterPositions.end(), rng);
 
-    for (int i = 0; i < numMonsters; i++) {
+    monsterBlocked.assign(maze.size(), false);
+    monsters.clear();
+    int placed = 0;
+    for (size_t i = 0; i < potentialMonsterPositions.size() && placed < numMonsters; i++) {
         int x = potentialMonsterPositions[i].first;
         int y = potentialMonsterPositions[i].second;
-        maze[y][x] = 'M'; // Place monster
+        if (isNearOtherMonster(x, y)) {
+            continue;
+        }
+        cell(x, y) = 'M'; // Place monster
+        monsters.push_back({y, x});
+        markMonsterSpacing(x, y);
+        placed++;
     }
 }
 
 /**
- * @brief Checks if there is another monster within a 5x5 grid around the given coordinates.
- * 
- * This function iterates through a 5x5 grid centered at the given (x, y) coordinates
- * to determine if there is a monster ('M') in any of the surrounding cells.
- * 
- * @param x The x-coordinate to check around.
- * @param y The y-coordinate to check around.
- * @return true If there is a monster within the 5x5 grid around the given coordinates.
- * @return false If there are no monsters within the 5x5 grid around the given coordinates.
+ * @brief Blocks the window around a newly placed monster for further placements.
+ *
+ * Every cell within MONSTER_SPACING (Chebyshev distance) of (x, y) is marked in
+ * monsterBlocked, so that isNearOtherMonster() reports it as too close.
+ *
+ * @param x The x-coordinate of the monster.
+ * @param y The y-coordinate of the monster.
  */
-bool Maze::isNearOtherMonster(int x, int y) {
-    for (int dx = -5; dx <= 5; dx++) {
-        for (int dy = -5; dy <= 5; dy++) {
-            int nx = x + dx;
-            int ny = y + dy;
-            if (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE && maze[ny][nx] == 'M') {
-                return true;
-            }
+void Maze::markMonsterSpacing(int x, int y) {
+    int minX = std::max(0, x - MONSTER_SPACING);
+    int maxX = std::min(width - 1, x + MONSTER_SPACING);
+    int minY = std::max(0, y - MONSTER_SPACING);
+    int maxY = std::min(height - 1, y + MONSTER_SPACING);
+    for (int ny = minY; ny <= maxY; ny++) {
+        for (int nx = minX; nx <= maxX; nx++) {
+            monsterBlocked[ny * width + nx] = true;
         }
     }
-    return false;
+}
+
+/**
+ * @brief Checks if a monster has been placed within MONSTER_SPACING of the given coordinates.
+ *
+ * The window around each placed monster is marked by markMonsterSpacing(), so
+ * this is a single lookup instead of a rescan of the surrounding cells.
+ *
+ * @param x The x-coordinate to check around.
+ * @param y The y-coordinate to check around.
+ * @return true If there is a monster within the (2 * MONSTER_SPACING + 1) square window around the given coordinates.
+ * @return false If there are no monsters within that window.
+ */
+bool Maze::isNearOtherMonster(int x, int y) const {
+    return monsterBlocked[static_cast<size_t>(y) * width + x];
 }
 
 /**
  * @brief Checks if the given cell (x, y) in the maze is a dead end.
  *
  * A cell is considered a dead end if it is a path cell and has only one adjacent path cell.
+ * Those are exactly the nodes of degree one in the corridor graph, so this is a lookup.
  *
  * @param x The x-coordinate of the cell to check.
  * @param y The y-coordinate of the cell to check.
  * @return true if the cell is a dead end, false otherwise.
  */
-bool Maze::isDeadEnd(int x, int y) {
-    if (maze[y][x] == PATH) {
-        int paths = 0;
-        for (const auto& direction : directions) {
-            int dx = direction[0];
-            int dy = direction[1];
-            if (x + dx >= 0 && x + dx < SIZE && y + dy >= 0 && y + dy < SIZE) {
-                if (maze[y + dy][x + dx] == PATH) {
-                    paths++;
-                }
-            }
-        }
-        // A dead end will only have one adjacent path
-        return paths == 1;
-    }
-    return false;
+bool Maze::isDeadEnd(int x, int y) const {
+    return corridors.isDeadEnd(y, x);
 }
 
 /**
@@ -232,15 +253,18 @@ bool Maze::isDeadEnd(int x, int y) {
  *   or the nearest path cell if the position is a wall.
  */
 void Maze::placeCheckpoints() {
+    checkpoints.clear();
+
     // Function to check if a cell is a path and not a wall
     auto isPath = [this](int x, int y) -> bool {
-        return maze[y][x] == PATH;
+        return cell(x, y) == PATH;
     };
 
     // Helper function to place a checkpoint if the position is not a wall
     auto tryPlacingCheckpoint = [this, &isPath](int x, int y) {
         if (isPath(x, y)) {
-            maze[y][x] = 'C';
+            cell(x, y) = 'C';
+            checkpoints.push_back({y, x});
             markNoMonsterZone(x, y); // Call this function whenever a checkpoint is placed
         } else {
             // Find the nearest path cell in the vicinity of the intended position
@@ -248,8 +272,9 @@ void Maze::placeCheckpoints() {
                 for (int dy = -1; dy <= 1; ++dy) {
                     int nx = x + dx;
                     int ny = y + dy;
-                    if (nx >= 0 && nx < SIZE && ny >= 0 && ny < SIZE && isPath(nx, ny)) {
-                        maze[ny][nx] = 'C';
+                    if (nx >= 0 && nx < width && ny >= 0 && ny < height && isPath(nx, ny)) {
+                        cell(nx, ny) = 'C';
+                        checkpoints.push_back({ny, nx});
                         markNoMonsterZone(nx, ny); // Mark the no-monster zone for this checkpoint
                         return; // Stop after placing one checkpoint
                     }
@@ -259,69 +284,92 @@ void Maze::placeCheckpoints() {
     };
 
     // Define the six positions for the checkpoints. Adjust as necessary for exact placement.
-    int middleY = SIZE / 2;
-    int offsetX = SIZE / 4; // Adjust offset as needed
-    int offsetY = SIZE / 4; // Adjust offset as needed
+    int middleY = height / 2;
+    int offsetX = width / 4; // Adjust offset as needed
+    int offsetY = height / 4; // Adjust offset as needed
 
     // Top-left
     tryPlacingCheckpoint(offsetX, offsetY);
     // Top-right
-    tryPlacingCheckpoint(SIZE - offsetX - 1, offsetY);
+    tryPlacingCheckpoint(width - offsetX - 1, offsetY);
     // Middle-left
     tryPlacingCheckpoint(offsetX, middleY);
     // Middle-right
-    tryPlacingCheckpoint(SIZE - offsetX - 1, middleY);
+    tryPlacingCheckpoint(width - offsetX - 1, middleY);
     // Bottom-left
-    tryPlacingCheckpoint(offsetX, SIZE - offsetY - 1);
+    tryPlacingCheckpoint(offsetX, height - offsetY - 1);
     // Bottom-right
-    tryPlacingCheckpoint(SIZE - offsetX - 1, SIZE - offsetY - 1);
+    tryPlacingCheckpoint(width - offsetX - 1, height - offsetY - 1);
 }
 
 /**
- * @brief Checks if a given cell (x, y) is on the specified path.
- * 
- * This function iterates through the linked list of cells representing the path
- * and checks if any cell in the path matches the given coordinates (x, y).
- * 
- * @param x The x-coordinate (column) of the cell to check.
- * @param y The y-coordinate (row) of the cell to check.
- * @param path A pointer to the head of the linked list representing the path.
- * @return true If the cell (x, y) is on the path.
- * @return false If the cell (x, y) is not on the path.
+ * @brief Records a path in pathMask so that isOnPath() is a single lookup.
+ *
+ * The previous mask is cleared, then every cell of the path is marked.
+ * Cells outside the maze are ignored.
+ *
+ * @param path The path as returned by solveMaze().
+ */
+void Maze::markPath(const std::vector<PathNode>& path) {
+    pathMask.assign(maze.size(), false);
+    for (const PathNode& step : path) {
+        if (step.col >= 0 && step.col < width && step.row >= 0 && step.row < height) {
+            pathMask[step.row * width + step.col] = true;
+        }
+    }
+}
+
+/**
+ * @brief Returns the character used for a cell in the saved maze.
+ *
+ * - 'C' represents a checkpoint.
+ * - 'M' represents a monster.
+ * - '#' represents a wall.
+ * - ' ' represents a path.
+ *
+ * @param x The x-coordinate (column) of the cell.
+ * @param y The y-coordinate (row) of the cell.
+ * @return The character for the cell.
+ */
+char Maze::glyph(int x, int y) const {
+    unsigned char value = cell(x, y);
+    if (value == 'C' || value == 'M') {
+        return value;
+    }
+    return value == WALL ? '#' : ' ';
+}
+
+/**
+ * @brief Converts the maze into one string per row, as stored in the saved maze.
+ *
+ * @return The rows of the maze from top to bottom.
  */
-bool Maze::isOnPath(int x, int y, Cell* path) {
-    while (path != nullptr) {
-        if (path->row == y && path->col == x) {
-            return true;
+std::vector<std::string> Maze::toRows() const {
+    std::vector<std::string> rows(height, std::string(width, ' '));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            rows[y][x] = glyph(x, y);
         }
-        path = path->next;
     }
-    return false;
+    return rows;
 }
 
 /**
  * @brief Prints the maze to the standard output.
  * 
  * This function iterates through the maze grid and prints each cell's content.
- * - 'C' represents a checkpoint and is printed as 'C'.
- * - 'M' represents a monster and is printed as 'M'.
- * - The starting point (1, 0) and the ending point (SIZE-2, SIZE-1) are printed as spaces.
- * - Walls are represented by the character '▓'.
- * - Empty spaces are printed as spaces.
+ * Walls are drawn as '▓', everything else as in the saved maze.
  * 
  * The maze is printed row by row.
  */
 void Maze::printMaze() {
-    for (int y = 0; y < SIZE; y++) {
-        for (int x = 0; x < SIZE; x++) {
-            if (maze[y][x] == 'C') { // Check for checkpoint and print 'C'
-                cout << "C";
-            } else if (maze[y][x] == 'M') { // Check for monster and print 'M'
-                cout << "M";
-            } else if (x == 1 && y == 0 || x == SIZE - 2 && y == SIZE - 1) {
-                cout << " ";
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            char c = glyph(x, y);
+            if (c == '#') {
+                cout << "▓";
             } else {
-                cout << (maze[y][x] == WALL ? "▓" : " ");  // "▓"
+                cout << c;
             }
         }
         cout << endl;
@@ -329,34 +377,67 @@ void Maze::printMaze() {
 }
 
 /**
- * @brief Saves the current state of the maze to a file.
+ * @brief Saves the current state of the maze to a binary file.
  *
- * This function writes the maze configuration to a file located at ".gameConfig/maze.txt".
- * The maze is represented as a grid of characters, where:
- * - 'C' represents a checkpoint.
- * - 'M' represents a monster.
- * - '#' represents a wall.
- * - ' ' represents a path.
+ * The file starts with a MazeFileHeader, followed by the checkpoint and monster
+ * positions and then one glyph() byte per cell (see mazeFile.h). Everything is
+ * assembled in memory and written with three bulk writes, so the file can be
+ * mapped and used by MappedMaze without any parsing.
+ * If the file cannot be opened, an error message is printed to the console.
  *
- * The function handles special cases for the start and end points of the maze.
+ * @param path The path of the file to write.
+ */
+void Maze::saveMaze(const std::string& path) const {
+    MazeFileHeader header;
+    memcpy(header.magic, MAZE_FILE_MAGIC, sizeof(header.magic));
+    header.version = MAZE_FILE_VERSION;
+    header.width = width;
+    header.height = height;
+    header.seed = seed;
+    header.checkpointCount = checkpoints.size();
+    header.monsterCount = monsters.size();
+
+    std::vector<MazeFilePos> positions;
+    positions.reserve(checkpoints.size() + monsters.size());
+    for (const PathNode& checkpoint : checkpoints) {
+        positions.push_back({static_cast<uint32_t>(checkpoint.row), static_cast<uint32_t>(checkpoint.col)});
+    }
+    for (const PathNode& monster : monsters) {
+        positions.push_back({static_cast<uint32_t>(monster.row), static_cast<uint32_t>(monster.col)});
+    }
+
+    std::vector<char> grid(maze.size());
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            grid[static_cast<size_t>(y) * width + x] = glyph(x, y);
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (file.is_open()) {
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(positions.data()), positions.size() * sizeof(MazeFilePos));
+        file.write(grid.data(), grid.size());
+        file.close();
+    } else {
+        cout << "Unable to open file";
+    }
+}
+
+/**
+ * @brief Exports the maze as text.
+ *
+ * This function writes the maze configuration to a text file, one row of glyph()
+ * characters per line, for people and tools that read the maze as text.
  * If the file cannot be opened, an error message is printed to the console.
+ *
+ * @param path The path of the file to write.
  */
-void Maze::saveMaze() {
-    std::ofstream file(".gameConfig/maze.txt"); // Corrected file path
+void Maze::exportText(const std::string& path) const {
+    std::ofstream file(path);
     if (file.is_open()) {
-        for (int y = 0; y < SIZE; y++) {
-            for (int x = 0; x < SIZE; x++) {
-                if (maze[y][x] == 'C') { // Check for checkpoint and print 'C'
-                    file << "C";
-                } else if (maze[y][x] == 'M') { // Check for monster and print 'M'
-                    file << "M";
-                } else if (x == 1 && y == 0 || x == SIZE - 2 && y == SIZE - 1) {
-                    file << " ";
-                } else {
-                    file << (maze[y][x] == WALL ? "#" : " "); // "#" for wall and " " for path
-                }
-            }
-            file << "\n";
+        for (const std::string& row : toRows()) {
+            file << row << "\n";
         }
         file.close();
     } else {
@@ -0,0 +1,193 @@
+#include "minefieldPool.h"
+#include "gameRandom.h"
+#include "minesweeper.h"
+#include "noguess.h"
+#include <algorithm>
+#include <cerrno>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * @brief Sets up the pool without generating anything yet.
+ *
+ * @param seed The game seed.
+ * @param noGuess True to generate minefields that can be cleared without guessing.
+ * @param firstEncounter The number of the next encounter.
+ * @param expectedSize The board size expected for the next encounter.
+ */
+MinefieldPool::MinefieldPool(uint64_t seed, bool noGuess, int firstEncounter, int expectedSize)
+    : seed(seed), noGuess(noGuess), lastTaken(firstEncounter - 1), expectedSize(expectedSize),
+      restartEncounter(firstEncounter) {}
+
+/**
+ * @brief Stops the thread if it is still running and closes the eventfd.
+ */
+MinefieldPool::~MinefieldPool() {
+    stop();
+    if (wakeFd >= 0) {
+        close(wakeFd);
+    }
+}
+
+/**
+ * @brief Creates the eventfd and starts the producer thread.
+ *
+ * @return true if the thread is running, false if the eventfd could not be created.
+ */
+bool MinefieldPool::start() {
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        return false;
+    }
+    running = true;
+    worker = thread(&MinefieldPool::run, this);
+    return true;
+}
+
+/**
+ * @brief Asks the producer thread to finish and waits for it.
+ *
+ * A minefield being generated is finished first, which takes at most one no-guess generation.
+ */
+void MinefieldPool::stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    running = false;
+    wake();
+    worker.join();
+}
+
+/**
+ * @brief Signals the eventfd the producer sleeps on, if there is one.
+ */
+void MinefieldPool::wake() {
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            // The counter is already non-zero, so the producer wakes up anyway
+        }
+    }
+}
+
+/**
+ * @brief Switches the producer to another board size.
+ *
+ * The encounter to restart from is published before the size, so a producer that sees
+ * the new size also sees where to start. The ring is then emptied; the minefields in it
+ * were generated at the old size, and popping them frees the slots for the new ones.
+ *
+ * @param size The board size of an encounter at the player's current row.
+ */
+void MinefieldPool::expect(int size) {
+    if (size == expectedSize.load(memory_order_relaxed)) {
+        return;
+    }
+    restartEncounter.store(lastTaken + 1, memory_order_relaxed);
+    expectedSize.store(size, memory_order_release);
+    while (ready.pop(current)) {
+    }
+    current = EncounterMinefield();
+    wake();
+}
+
+/**
+ * @brief Takes the minefield of an encounter from the ring, or generates it if it is not there.
+ *
+ * Popping a minefield moves it out of the ring, and the board is moved out again, so a hit
+ * costs no copy and no generation. Minefields of earlier encounters and ones generated at
+ * another size are skipped. Every pop frees a slot and wakes the producer.
+ *
+ * @param encounter The number of the encounter.
+ * @param size The side length of the board.
+ * @return The minefield, safe around (size / 2, size / 2).
+ */
+Board MinefieldPool::take(int encounter, int size) {
+    lastTaken = encounter;
+    auto hit = [&]() { return current.encounter == encounter && current.size == size && current.board.size() > 0; };
+    while (!hit() && current.encounter <= encounter && ready.pop(current)) {
+        wake();
+    }
+    if (hit()) {
+        return move(current.board);
+    }
+    missCount++;
+    return generate(seed, encounter, size, noGuess, 0);
+}
+
+/**
+ * @brief Generates the minefield of an encounter around the centre of the board.
+ *
+ * The seed of encounter k is the SEED_STREAM_MINEFIELDS + k - 1 stream of the game seed,
+ * and the mines are encounterMines(size), capped so that the safe 3 x 3 block fits.
+ *
+ * @param seed The game seed.
+ * @param encounter The number of the encounter.
+ * @param size The side length of the board.
+ * @param noGuess True for a minefield that can be cleared without guessing.
+ * @param threads The worker threads of no-guess generation; values below 1 mean one per hardware thread.
+ * @return The minefield.
+ */
+Board MinefieldPool::generate(uint64_t seed, int encounter, int size, bool noGuess, int threads) {
+    uint64_t minefieldSeed = deriveSeed(seed, SEED_STREAM_MINEFIELDS + encounter - 1);
+    int mines = min(encounterMines(size), max(0, size * size - 9));
+    int centre = size / 2;
+    return noGuess ? generateNoGuessMinefield(minefieldSeed, size, mines, centre, centre, threads)
+                   : generateMinefield(minefieldSeed, size, mines, centre, centre);
+}
+
+/**
+ * @brief The producer thread: generates the minefields of the coming encounters and queues them.
+ *
+ * Each minefield is generated at the size last passed to expect(); when that changes, the
+ * minefield at hand is dropped and the thread starts over from the encounter expect()
+ * published, and the size is checked again after every generation so that a change
+ * during one is not queued. While the ring is full the thread sleeps until take() frees
+ * a slot, expect() changes the size or stop() is called. The thread runs under
+ * SCHED_IDLE, so it only gets a core the game does not want: the wake-up from take() does
+ * not preempt the encounter it serves. A no-guess minefield is generated on this thread
+ * alone, so the game keeps the other cores.
+ */
+void MinefieldPool::run() {
+    struct sched_param idle = {};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &idle); // Keeps the normal priority if refused
+
+    struct pollfd wake = {};
+    wake.fd = wakeFd;
+    wake.events = POLLIN;
+
+    EncounterMinefield next;
+    int size = 0;
+    int nextEncounter = 0;
+    while (running) {
+        int expected = expectedSize.load(memory_order_acquire);
+        if (expected != size) {
+            size = expected;
+            nextEncounter = restartEncounter.load(memory_order_relaxed);
+            next = EncounterMinefield();
+        }
+        if (next.board.size() == 0) {
+            next.encounter = nextEncounter;
+            next.size = size;
+            next.board = generate(seed, nextEncounter, size, noGuess);
+            continue; // Checks the size again before queueing
+        }
+        if (ready.push(move(next))) {
+            next = EncounterMinefield();
+            nextEncounter++;
+            continue;
+        }
+        if (poll(&wake, 1, -1) < 0 && errno != EINTR) {
+            break;
+        }
+        uint64_t counter;
+        if (read(wakeFd, &counter, sizeof(counter)) < 0) {
+            counter = 0;
+        }
+    }
+}
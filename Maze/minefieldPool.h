@@ -0,0 +1,120 @@
+#ifndef MINEFIELDPOOL_H
+#define MINEFIELDPOOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "board.h"
+#include "ms_config.h"
+#include "spscQueue.h"
+
+#define MINEFIELD_POOL_DEPTH 2 // Encounters whose minefields are generated ahead of time; a power of two
+
+/**
+ * @struct EncounterMinefield
+ * @brief The minefield of one encounter at the board size expected for it.
+ */
+struct EncounterMinefield {
+    int encounter = 0; /**< The number of the encounter, counted from 1 */
+    int size = 0; /**< The side length of the board */
+    Board board = Board(0, 0); /**< The minefield */
+};
+
+/**
+ * @class MinefieldPool
+ * @brief Generates the minefields of the coming encounters on a background thread.
+ *
+ * The board size of an encounter depends on the row where it happens, so the game tells the
+ * pool with expect() which size the player's row calls for, and the producer generates the
+ * coming encounters at that size only. The minefields are queued in a lock-free
+ * single-producer/single-consumer ring; the producer keeps MINEFIELD_POOL_DEPTH encounters
+ * ahead and sleeps on an eventfd while the ring is full. When the player crosses into
+ * another size band, expect() empties the ring from the consumer side and wakes the
+ * producer, which starts over at the next encounter with the new size. A minefield the
+ * producer queued just before it noticed is skipped by take().
+ *
+ * Every minefield is safe around the centre of the board, where the game makes the first
+ * reveal, and is derived from the game seed, the encounter number and the size only. take()
+ * thus returns the same minefield whether it comes from the ring or, if the producer has
+ * fallen behind or guessed the size wrong, is generated on the spot.
+ */
+class MinefieldPool {
+public:
+    /**
+     * @brief Sets up the pool; the producer is started by start().
+     * @param seed The game seed
+     * @param noGuess True to generate minefields that can be cleared without guessing
+     * @param firstEncounter The number of the next encounter
+     * @param expectedSize The board size expected for the next encounter
+     */
+    MinefieldPool(uint64_t seed, bool noGuess, int firstEncounter = 1, int expectedSize = MSIZE);
+    ~MinefieldPool();
+
+    MinefieldPool(const MinefieldPool &) = delete;
+    MinefieldPool &operator=(const MinefieldPool &) = delete;
+
+    /**
+     * @brief Starts the producer thread.
+     * @return True if the thread is running, false if its eventfd could not be created
+     */
+    bool start();
+
+    /**
+     * @brief Stops and joins the producer thread.
+     */
+    void stop();
+
+    /**
+     * @brief Sets the board size the producer generates the coming minefields at.
+     *
+     * Must only be called from the thread that calls take(). A new size drops the queued
+     * minefields and has the producer generate them again at that size.
+     *
+     * @param size The board size of an encounter at the player's current row
+     */
+    void expect(int size);
+
+    /**
+     * @brief Returns the minefield of an encounter. Must only be called from one (the UI) thread.
+     *
+     * Encounters must be taken in increasing order; minefields of earlier encounters are dropped.
+     *
+     * @param encounter The number of the encounter
+     * @param size The side length of the board
+     * @return The minefield, safe around (size / 2, size / 2)
+     */
+    Board take(int encounter, int size);
+
+    /** @brief Returns how many take() calls had to generate their minefield themselves. */
+    int misses() const { return missCount; }
+
+    /**
+     * @brief Generates the minefield of an encounter, as the producer does.
+     * @param seed The game seed
+     * @param encounter The number of the encounter
+     * @param size The side length of the board
+     * @param noGuess True for a minefield that can be cleared without guessing
+     * @param threads The worker threads of no-guess generation; values below 1 mean one per hardware thread
+     * @return The minefield, safe around (size / 2, size / 2)
+     */
+    static Board generate(uint64_t seed, int encounter, int size, bool noGuess, int threads = 1);
+
+private:
+    void run();
+    void wake();
+
+    uint64_t seed; /**< The game seed */
+    bool noGuess; /**< True to generate no-guess minefields */
+    EncounterMinefield current; /**< The minefield last taken from the ring, only touched by the consumer */
+    int lastTaken; /**< The encounter last passed to take(), only touched by the consumer */
+    int missCount = 0; /**< take() calls that generated their own minefield */
+
+    std::atomic<int> expectedSize; /**< The board size the producer generates at, set by expect() */
+    std::atomic<int> restartEncounter; /**< The encounter the producer starts from after a size change */
+    SpscQueue<EncounterMinefield, MINEFIELD_POOL_DEPTH> ready; /**< Minefields waiting for their encounter */
+    int wakeFd = -1; /**< eventfd signalled when a slot frees up or the pool stops */
+    std::atomic<bool> running{false}; /**< Cleared by stop() to end the thread */
+    std::thread worker; /**< The producer thread */
+};
+
+#endif
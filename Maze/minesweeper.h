@@ -1,6 +1,21 @@
 #ifndef MINESWEEPER_H
 #define MINESWEEPER_H
 
-int minesweeper();
+#include "ms_config.h"
+#include "board.h"
+#include "bitboard.h"
+#include "minewseepergen.h"
+#include "floodfill.h"
+#include <chrono>
+#include <cstdint>
+
+bool revealPos(const Board &cord, GameBoard &gameBoard, int row, int col, FloodScratch &scratch);
+bool checkIfGameWin(const GameBoard &cord);
+void loadMinefield(BitBoard &cord);
+bool revealPos(BitBoard &board, int row, int col);
+bool checkIfGameWin(const BitBoard &cord);
+int minesweeper(const Board &mf, std::chrono::steady_clock::time_point *firstFrame = nullptr);
+int encounterBoardSize(int row, int height);
+int encounterMines(int size);
 
 #endif
\ No newline at end of file
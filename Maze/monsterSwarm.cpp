@@ -0,0 +1,166 @@
+#include "monsterSwarm.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Sets up an empty swarm on the corridors of a maze.
+ *
+ * @param graph The corridor graph of the whole maze.
+ * @param height The number of rows of the maze.
+ * @param seed The seed for the starting directions.
+ */
+MonsterSwarm::MonsterSwarm(const CorridorGraph &graph, int height, uint64_t seed)
+    : graph(graph), rng(seed), height(height) {}
+
+/**
+ * @brief Adds a monster on the corridor through a cell, heading a random way along it.
+ *
+ * An end of the corridor that lies on the first or last row is not entered, so the
+ * monster turns one cell before it; a corridor that leaves no room for that holds a
+ * monster that stays.
+ *
+ * @param row The row of the monster.
+ * @param col The column of the monster.
+ */
+void MonsterSwarm::add(int row, int col) {
+    int corridor;
+    int at;
+    y.push_back(row);
+    x.push_back(col);
+    base.push_back(0);
+    sorted = false;
+    if (!graph.locate(row, col, corridor, at)) {
+        edge.push_back(-1);
+        low.push_back(0);
+        high.push_back(0);
+        offset.push_back(0);
+        heading.push_back(0);
+        return;
+    }
+    int length = graph.edgeAt(corridor).length;
+    auto outside = [&](int k) {
+        int cellRow = graph.edgeCell(corridor, k).row;
+        return cellRow <= 0 || cellRow >= height - 1;
+    };
+    int first = outside(0) ? 1 : 0;
+    int last = outside(length) ? length - 1 : length;
+    last = max(first, last);
+    at = max(first, min(at, last));
+    int dir = randomBelow(rng, 2) == 0 ? -1 : 1;
+    if (first == last) {
+        dir = 0;
+    } else if (at <= first) {
+        dir = 1;
+    } else if (at >= last) {
+        dir = -1;
+    }
+    edge.push_back(corridor);
+    low.push_back(first);
+    high.push_back(last);
+    offset.push_back(at);
+    heading.push_back(dir);
+}
+
+/**
+ * @brief Sorts the monsters by edge and copies the cells of their edges into route.
+ *
+ * Monsters on the same edge share one copy of its cells, and a monster that stays gets
+ * a copy of its own cell. The sort is stable, so the order only depends on the adds.
+ */
+void MonsterSwarm::sortByEdge() {
+    const int n = size();
+    vector<int> order(n);
+    for (int i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return edge[a] < edge[b]; });
+    auto permute = [&](vector<int> &values) {
+        vector<int> sortedValues(n);
+        for (int i = 0; i < n; ++i) {
+            sortedValues[i] = values[order[i]];
+        }
+        values.swap(sortedValues);
+    };
+    for (vector<int> *values : {&y, &x, &edge, &low, &high, &offset, &heading}) {
+        permute(*values);
+    }
+
+    route.clear();
+    for (int i = 0; i < n; ++i) {
+        if (edge[i] < 0) {
+            base[i] = static_cast<int>(route.size());
+            route.push_back({y[i], x[i]});
+            offset[i] = 0;
+        } else if (i > 0 && edge[i] == edge[i - 1]) {
+            base[i] = base[i - 1];
+        } else {
+            base[i] = static_cast<int>(route.size());
+            for (int k = 0; k <= graph.edgeAt(edge[i]).length; ++k) {
+                route.push_back(graph.edgeCell(edge[i], k));
+            }
+        }
+    }
+    sorted = true;
+}
+
+/**
+ * @brief Moves every monster one cell along its corridor, turning back at its end nodes.
+ *
+ * Each iteration advances the offset, flips the heading arithmetically when the new
+ * offset is one of the monster's two turning points and reads the cell from the route,
+ * so the loop has no data-dependent branches.
+ */
+void MonsterSwarm::step() {
+    if (!sorted) {
+        sortByEdge();
+    }
+    const PathNode *cells = route.data();
+    int *py = y.data();
+    int *px = x.data();
+    const int *pbase = base.data();
+    const int *plow = low.data();
+    const int *phigh = high.data();
+    int *poffset = offset.data();
+    int *pheading = heading.data();
+    const int n = size();
+    for (int i = 0; i < n; ++i) {
+        int at = poffset[i] + pheading[i];
+        int turn = (at == plow[i]) | (at == phigh[i]);
+        pheading[i] -= 2 * pheading[i] * turn;
+        poffset[i] = at;
+        const PathNode &cell = cells[pbase[i] + at];
+        py[i] = cell.row;
+        px[i] = cell.col;
+    }
+}
+
+/**
+ * @brief Checks if any monster is on a cell.
+ *
+ * @param row The row to check.
+ * @param col The column to check.
+ * @return true if at least one monster is on (row, col).
+ */
+bool MonsterSwarm::occupies(int row, int col) const {
+    const int *py = y.data();
+    const int *px = x.data();
+    const int n = size();
+    int hit = 0;
+    for (int i = 0; i < n; ++i) {
+        hit |= (py[i] == row) & (px[i] == col);
+    }
+    return hit != 0;
+}
+
+/**
+ * @brief Copies the (row, column) positions of all monsters.
+ *
+ * @param out Receives the positions.
+ */
+void MonsterSwarm::positions(vector<pair<int, int>> &out) const {
+    out.resize(y.size());
+    for (size_t i = 0; i < y.size(); ++i) {
+        out[i] = make_pair(y[i], x[i]);
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef MONSTERSWARM_H
+#define MONSTERSWARM_H
+
+#include <utility>
+#include <vector>
+#include "corridorGraph.h"
+#include "gameRandom.h"
+
+/**
+ * @class MonsterSwarm
+ * @brief Stores every monster as a structure of arrays and moves them all in one batch.
+ *
+ * Monsters patrol the maze's own CorridorGraph, the one Maze::generateMaze() builds, and
+ * every monster is bound to the corridor it starts on: it walks along that edge and turns
+ * back whenever it reaches one of the edge's two end nodes, so it guards a single stretch
+ * of the maze between a junction and a dead end or another junction. The monsters are
+ * sorted by edge and the cells of their edges copied into one array in that order, so a
+ * monster's state is its edge's first cell, the two offsets it turns at, its offset along
+ * the edge and its heading, and a step is an add, two compares and one lookup, with no
+ * branches, for the whole population in a single loop that reads the array front to back.
+ *
+ * The entrance and exit rows are walls to monsters: a corridor ending on one of them is
+ * cut one cell short, so no monster leaves the maze.
+ */
+class MonsterSwarm {
+public:
+    /**
+     * @brief Sets up an empty swarm on the corridors of a maze.
+     * @param graph The corridor graph of the whole maze. Must outlive the swarm.
+     * @param height The number of rows of the maze; the first and last rows are never entered
+     * @param seed The seed for the starting directions
+     */
+    MonsterSwarm(const CorridorGraph &graph, int height, uint64_t seed);
+
+    /**
+     * @brief Adds a monster on the corridor through a cell, heading a random way along it.
+     *
+     * A monster on a junction takes one of its corridors; one on a cell that belongs to no
+     * corridor stays where it is.
+     *
+     * @param y The row of the monster
+     * @param x The column of the monster
+     */
+    void add(int y, int x);
+
+    /**
+     * @brief Moves every monster one cell along its corridor, turning back at its end nodes.
+     *
+     * The first step after add() sorts the monsters by edge.
+     */
+    void step();
+
+    /**
+     * @brief Checks if any monster is on a cell.
+     * @param y The row to check
+     * @param x The column to check
+     * @return True if at least one monster is on (y, x)
+     */
+    bool occupies(int y, int x) const;
+
+    /**
+     * @brief Copies the (row, column) positions of all monsters.
+     * @param out Receives the positions; its capacity is reused
+     */
+    void positions(std::vector<std::pair<int, int>> &out) const;
+
+    /**
+     * @brief Returns the number of monsters.
+     * @return The number of monsters
+     */
+    int size() const { return static_cast<int>(y.size()); }
+
+private:
+    void sortByEdge();
+
+    const CorridorGraph &graph; /**< The corridors of the maze */
+    GameRng rng; /**< Draws the starting directions */
+    int height; /**< The number of rows of the maze */
+    std::vector<PathNode> route; /**< The cells of the monsters' edges in monster order, one copy per edge */
+    std::vector<int> y; /**< The row of each monster */
+    std::vector<int> x; /**< The column of each monster */
+    std::vector<int> edge; /**< The edge of each monster, -1 for a monster that stays */
+    std::vector<int> base; /**< Index into route of the first cell of each monster's edge */
+    std::vector<int> low; /**< The offset each monster turns forward at */
+    std::vector<int> high; /**< The offset each monster turns back at; equal to low for a monster that stays */
+    std::vector<int> offset; /**< The offset of each monster along its edge */
+    std::vector<int> heading; /**< The offset change per step of each monster (-1, 0 or 1) */
+    bool sorted = true; /**< False after add() until the next step() sorts the monsters and rebuilds route */
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "pathfinder.h"
+#include "corridorGraph.h"
+#include <climits>
+#include <cstdlib>
+#include <utility>
+
+using namespace std;
+
+/**
+ * @brief Rebuilds the path from the goal back to the start using the parent array.
+ *
+ * @param parent The parent index of every reached cell; the start cell is its own parent.
+ * @param width The number of columns of the grid.
+ * @param goalIndex The flat index of the goal cell.
+ * @return The cells from start to goal inclusive.
+ */
+static vector<PathNode> buildPath(const vector<int> &parent, int width, int goalIndex) {
+    size_t length = 1;
+    for (int i = goalIndex; parent[i] != i; i = parent[i]) {
+        length++;
+    }
+
+    vector<PathNode> path(length);
+    int i = goalIndex;
+    for (size_t step = length; step-- > 0; i = parent[i]) {
+        path[step] = {i / width, i % width};
+    }
+    return path;
+}
+
+/**
+ * @brief Collects the walkable, in-bounds neighbours of a cell.
+ *
+ * @param grid The grid, row-major with width * height cells.
+ * @param width The number of columns of the grid.
+ * @param height The number of rows of the grid.
+ * @param wall The cell value that blocks movement.
+ * @param index The flat index of the cell.
+ * @param out Receives up to four neighbour indices.
+ * @return The number of neighbours written to out.
+ */
+static int walkableNeighbours(const unsigned char *grid, int width, int height, unsigned char wall, int index, int out[4]) {
+    int row = index / width;
+    int col = index % width;
+    int count = 0;
+    if (row > 0 && grid[index - width] != wall) out[count++] = index - width;
+    if (row + 1 < height && grid[index + width] != wall) out[count++] = index + width;
+    if (col > 0 && grid[index - 1] != wall) out[count++] = index - 1;
+    if (col + 1 < width && grid[index + 1] != wall) out[count++] = index + 1;
+    return count;
+}
+
+/**
+ * @brief Finds the shortest path between two cells of a flat, row-major grid.
+ *
+ * BFS expands cells in order of distance using a preallocated ring of cell indices.
+ * A* orders cells by f = g + h, where h is the Manhattan distance to the goal; since h never
+ * overestimates, the first time the goal is popped its path is the shortest. One step
+ * changes g by 1 and h by 1 either way, so a neighbour's f is the current f or f + 2 and
+ * the open list is a bucket queue of just two stacks, one per f value, with O(1) push and
+ * pop. Each stack pops the cell pushed last, so ties on f go to the cell found last, one
+ * step nearer the goal than the cell that found it: the search dives down the corridor
+ * that leads to the goal instead of widening across every cell of equal f.
+ * Both variants record the parent of each reached cell in one flat array, which also
+ * serves as the visited set. Corridor builds a CorridorGraph with start and goal pinned
+ * as nodes and searches that instead; callers that solve the same grid repeatedly
+ * should keep the graph and call CorridorGraph::shortestPath() directly.
+ *
+ * @param grid The grid, row-major with width * height cells.
+ * @param width The number of columns of the grid.
+ * @param height The number of rows of the grid.
+ * @param wall The cell value that blocks movement; every other value is walkable.
+ * @param start The cell to start from.
+ * @param goal The cell to reach.
+ * @param algorithm The search strategy to use.
+ * @return The cells from start to goal inclusive, or an empty vector if the goal is unreachable.
+ */
+vector<PathNode> solveMaze(const unsigned char *grid, int width, int height, unsigned char wall,
+                           PathNode start, PathNode goal, PathAlgorithm algorithm) {
+    if (width <= 0 || height <= 0 ||
+        start.row < 0 || start.row >= height || start.col < 0 || start.col >= width ||
+        goal.row < 0 || goal.row >= height || goal.col < 0 || goal.col >= width) {
+        return vector<PathNode>();
+    }
+
+    int startIndex = start.row * width + start.col;
+    int goalIndex = goal.row * width + goal.col;
+    if (grid[startIndex] == wall || grid[goalIndex] == wall) {
+        return vector<PathNode>();
+    }
+
+    if (algorithm == PathAlgorithm::Corridor) {
+        return CorridorGraph(grid, width, height, wall, vector<PathNode>{start, goal}).shortestPath(start, goal);
+    }
+
+    size_t cells = static_cast<size_t>(width) * height;
+    vector<int> parent(cells, -1);
+    parent[startIndex] = startIndex;
+
+    int neighbours[4];
+
+    if (algorithm == PathAlgorithm::BFS) {
+        vector<int> frontier(cells); // Every cell is enqueued at most once
+        size_t head = 0;
+        size_t tail = 0;
+        frontier[tail++] = startIndex;
+        while (head < tail) {
+            int current = frontier[head++];
+            if (current == goalIndex) {
+                return buildPath(parent, width, goalIndex);
+            }
+            int count = walkableNeighbours(grid, width, height, wall, current, neighbours);
+            for (int n = 0; n < count; n++) {
+                int next = neighbours[n];
+                if (parent[next] == -1) {
+                    parent[next] = current;
+                    frontier[tail++] = next;
+                }
+            }
+        }
+        return vector<PathNode>();
+    }
+
+    vector<int> cost(cells, INT_MAX);
+    cost[startIndex] = 0;
+    auto heuristic = [&](int index) {
+        return abs(index / width - goal.row) + abs(index % width - goal.col);
+    };
+    vector<int> current; // Open cells with f == bound
+    vector<int> later; // Open cells with f == bound + 2
+    int bound = heuristic(startIndex);
+    current.push_back(startIndex);
+    while (!current.empty()) {
+        int cell = current.back();
+        current.pop_back();
+        if (cell == goalIndex) {
+            return buildPath(parent, width, goalIndex);
+        }
+        if (bound - heuristic(cell) == cost[cell]) {
+            int count = walkableNeighbours(grid, width, height, wall, cell, neighbours);
+            for (int n = 0; n < count; n++) {
+                int next = neighbours[n];
+                int nextCost = cost[cell] + 1;
+                if (nextCost < cost[next]) {
+                    cost[next] = nextCost;
+                    parent[next] = cell;
+                    (nextCost + heuristic(next) == bound ? current : later).push_back(next);
+                }
+            }
+        } // Otherwise the entry is stale, a cheaper route was found after it was pushed
+        if (current.empty()) {
+            swap(current, later);
+            bound += 2;
+        }
+    }
+    return vector<PathNode>();
+}
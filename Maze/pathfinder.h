@@ -0,0 +1,42 @@
+#ifndef PATHFINDER_H
+#define PATHFINDER_H
+
+#include <vector>
+
+/**
+ * @brief The search strategies supported by the pathfinding engine.
+ */
+enum class PathAlgorithm {
+    BFS,     /**< Breadth-first search, shortest path in unweighted grids */
+    AStar,   /**< A* search guided by the Manhattan distance to the goal */
+    Corridor /**< Search over the junctions of a CorridorGraph, weighted by corridor length */
+};
+
+/**
+ * @struct PathNode
+ * @brief A single step of a path, stored by value in a contiguous vector.
+ */
+struct PathNode {
+    int row; /**< The row (y-coordinate) of the step */
+    int col; /**< The column (x-coordinate) of the step */
+};
+
+/**
+ * @brief Finds the shortest path between two cells of a flat, row-major grid.
+ *
+ * The search is iterative and keeps one parent index per cell in a preallocated
+ * array, so its memory use is linear in the grid size and independent of the path shape.
+ *
+ * @param grid The grid, row-major with width * height cells.
+ * @param width The number of columns of the grid.
+ * @param height The number of rows of the grid.
+ * @param wall The cell value that blocks movement; every other value is walkable.
+ * @param start The cell to start from.
+ * @param goal The cell to reach.
+ * @param algorithm The search strategy to use.
+ * @return The cells from start to goal inclusive, or an empty vector if the goal is unreachable.
+ */
+std::vector<PathNode> solveMaze(const unsigned char *grid, int width, int height, unsigned char wall,
+                                PathNode start, PathNode goal, PathAlgorithm algorithm = PathAlgorithm::BFS);
+
+#endif
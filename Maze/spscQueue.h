@@ -0,0 +1,76 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @class SpscQueue
+ * @brief A bounded, lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * The producer only writes `tail` and the consumer only writes `head`. A slot is
+ * published by the release store of `tail` and handed back by the release store of
+ * `head`, so each side sees the other's writes to the slot through the matching
+ * acquire load.
+ *
+ * @tparam T The element type, copied or moved into the ring and moved out of it.
+ * @tparam Capacity The number of slots, which must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /**
+     * @brief Appends an element. Must only be called by the producer thread.
+     * @param value The element to append
+     * @return True if the element was queued, false if the queue is full
+     */
+    bool push(const T &value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[t & (Capacity - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves an element in. Must only be called by the producer thread.
+     * @param value The element to append; left untouched if the queue is full
+     * @return True if the element was queued, false if the queue is full
+     */
+    bool push(T &&value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[t & (Capacity - 1)] = std::move(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element. Must only be called by the consumer thread.
+     * @param value Receives the element
+     * @return True if an element was removed, false if the queue is empty
+     */
+    bool pop(T &value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots[h & (Capacity - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T slots[Capacity]; /**< The ring of elements */
+    std::atomic<size_t> head{0}; /**< The number of elements popped so far */
+    std::atomic<size_t> tail{0}; /**< The number of elements pushed so far */
+};
+
+#endif
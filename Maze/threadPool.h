@@ -0,0 +1,52 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns the number of worker threads to use by default.
+ * @return The number of hardware threads, at least 1
+ */
+inline int defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Runs job(i) for every i in [0, count) on a pool of worker threads.
+ *
+ * The workers pull the next index from a shared atomic counter, so uneven jobs
+ * balance themselves and no work is assigned up front. job(i, worker) receives
+ * the index of the worker thread as well, for per-thread scratch state. The call
+ * returns once every job has finished.
+ *
+ * @param count The number of jobs
+ * @param threads The number of worker threads; values below 1 mean defaultThreadCount()
+ * @param job The work to run, called as job(index, worker)
+ */
+template <typename Job>
+void parallelFor(int count, int threads, Job job) {
+    if (threads < 1) {
+        threads = defaultThreadCount();
+    }
+    threads = std::max(1, std::min(threads, count));
+    std::atomic<int> next{0};
+    auto worker = [&](int id) {
+        for (int i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            job(i, id);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int id = 1; id < threads; id++) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0); // The calling thread works too
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+#endif
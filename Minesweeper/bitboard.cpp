@@ -0,0 +1,389 @@
+#include "bitboard.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Returns word w of a row with every cell moved one column right, so bit c holds column c - 1.
+ * @param row The words of the row
+ * @param w The word to return
+ */
+static inline uint64_t fromLeft(const uint64_t *row, int w) {
+    return (row[w] << 1) | (w > 0 ? row[w - 1] >> 63 : 0);
+}
+
+/**
+ * @brief Returns word w of a row with every cell moved one column left, so bit c holds column c + 1.
+ * @param row The words of the row
+ * @param w The word to return
+ * @param words The number of words of the row
+ */
+static inline uint64_t fromRight(const uint64_t *row, int w, int words) {
+    return (row[w] >> 1) | (w + 1 < words ? row[w + 1] << 63 : 0);
+}
+
+/**
+ * @brief Spreads the set bits of gen towards bit 63 along the runs of set bits of pro.
+ *
+ * Kogge-Stone occluded fill: six shift-and-mask steps cover a whole word.
+ *
+ * @param gen The seeds, a subset of pro
+ * @param pro The cells the fill may pass through
+ * @return gen plus every bit of pro reached from it
+ */
+static inline uint64_t fillUp(uint64_t gen, uint64_t pro) {
+    gen |= pro & (gen << 1);
+    pro &= pro << 1;
+    gen |= pro & (gen << 2);
+    pro &= pro << 2;
+    gen |= pro & (gen << 4);
+    pro &= pro << 4;
+    gen |= pro & (gen << 8);
+    pro &= pro << 8;
+    gen |= pro & (gen << 16);
+    pro &= pro << 16;
+    return gen | (pro & (gen << 32));
+}
+
+/**
+ * @brief Spreads the set bits of gen towards bit 0 along the runs of set bits of pro.
+ * @param gen The seeds, a subset of pro
+ * @param pro The cells the fill may pass through
+ * @return gen plus every bit of pro reached from it
+ */
+static inline uint64_t fillDown(uint64_t gen, uint64_t pro) {
+    gen |= pro & (gen >> 1);
+    pro &= pro >> 1;
+    gen |= pro & (gen >> 2);
+    pro &= pro >> 2;
+    gen |= pro & (gen >> 4);
+    pro &= pro >> 4;
+    gen |= pro & (gen >> 8);
+    pro &= pro >> 8;
+    gen |= pro & (gen >> 16);
+    pro &= pro >> 16;
+    return gen | (pro & (gen >> 32));
+}
+
+/**
+ * @brief Creates a board without mines, every cell hidden.
+ *
+ * Every plane is allocated here at its full size, so placing mines, counting and
+ * revealing never allocate.
+ *
+ * @param width The number of columns
+ * @param height The number of rows
+ */
+BitBoard::BitBoard(int width, int height)
+    : cols(width), rows(height), words((width + 63) / 64),
+      tail(width % 64 ? (uint64_t(1) << (width % 64)) - 1 : ~uint64_t(0)) {
+    const size_t planeWords = static_cast<size_t>(words) * rows;
+    mines.assign(planeWords, 0);
+    revealed.assign(planeWords, 0);
+    flagged.assign(planeWords, 0);
+    for (vector<uint64_t> &plane : counts) {
+        plane.assign(planeWords, 0);
+    }
+    blank.assign(planeWords, 0);
+    opening.assign(planeWords, 0);
+    pushDown.assign(rows, 0);
+    pushUp.assign(rows, 0);
+    safeHidden = static_cast<int>(size());
+}
+
+/**
+ * @brief Creates a hidden board holding the mines of a char minefield and counts their neighbours.
+ * @param minefield The minefield, 'X' marking a mine
+ */
+BitBoard::BitBoard(const Board &minefield) : BitBoard(minefield.width(), minefield.height()) {
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            if (minefield.at(r, c) == 'X') {
+                placeMine(r, c);
+            }
+        }
+    }
+    countNeighbours();
+}
+
+/**
+ * @brief Returns a cell of the minefield: 'X' for a mine, '1' to '8' or ' '.
+ *
+ * The count is put back together from its four bit-sliced planes.
+ *
+ * @param row The row of the cell
+ * @param col The column of the cell
+ * @return The character of the cell in a char minefield
+ */
+char BitBoard::minefieldAt(int row, int col) const {
+    if (isMine(row, col)) {
+        return 'X';
+    }
+    int count = test(counts[0], row, col) | test(counts[1], row, col) << 1 | test(counts[2], row, col) << 2 |
+                test(counts[3], row, col) << 3;
+    return count > 0 ? static_cast<char>('0' + count) : ' ';
+}
+
+/**
+ * @brief Returns a cell as the player sees it.
+ * @param row The row of the cell
+ * @param col The column of the cell
+ * @return '#' if hidden, 'F' if flagged, otherwise minefieldAt()
+ */
+char BitBoard::at(int row, int col) const {
+    if (isRevealed(row, col)) {
+        return minefieldAt(row, col);
+    }
+    return isFlagged(row, col) ? 'F' : '#';
+}
+
+/**
+ * @brief Removes every mine, flag and revealed cell, keeping the planes allocated.
+ */
+void BitBoard::reset() {
+    fill(mines.begin(), mines.end(), 0);
+    fill(revealed.begin(), revealed.end(), 0);
+    fill(flagged.begin(), flagged.end(), 0);
+    for (vector<uint64_t> &plane : counts) {
+        fill(plane.begin(), plane.end(), 0);
+    }
+    fill(blank.begin(), blank.end(), 0);
+    mineCount = 0;
+    flags = 0;
+    safeHidden = static_cast<int>(size());
+}
+
+/**
+ * @brief Hides every cell again and removes the flags, keeping the mines and their counts.
+ */
+void BitBoard::cover() {
+    fill(revealed.begin(), revealed.end(), 0);
+    fill(flagged.begin(), flagged.end(), 0);
+    flags = 0;
+    safeHidden = static_cast<int>(size()) - mineCount;
+}
+
+/**
+ * @brief Puts a mine on a cell; a cell that already holds one is not counted twice.
+ * @param row The row of the cell
+ * @param col The column of the cell
+ */
+void BitBoard::placeMine(int row, int col) {
+    uint64_t &word = mines[static_cast<size_t>(row) * words + (col >> 6)];
+    uint64_t bit = uint64_t(1) << (col & 63);
+    mineCount += !(word & bit);
+    word |= bit;
+}
+
+/**
+ * @brief Computes the bit-sliced neighbour counts and the blank plane from the mine plane.
+ *
+ * Each row is summed with the rows above and below into a 2-bit column sum, then each
+ * column with its left and right neighbours into the 4-bit count, with bitwise adders on
+ * whole words. The number of covered safe cells is recounted at the same time, so cells
+ * revealed before the call stay counted as uncovered.
+ */
+void BitBoard::countNeighbours() {
+    vector<uint64_t> low(words);
+    vector<uint64_t> high(words);
+    int uncoveredSafe = 0;
+    for (int r = 0; r < rows; r++) {
+        const size_t begin = static_cast<size_t>(r) * words;
+        const uint64_t *above = r > 0 ? &mines[begin - words] : nullptr;
+        const uint64_t *middle = &mines[begin];
+        const uint64_t *below = r + 1 < rows ? &mines[begin + words] : nullptr;
+
+        // Column sums of the three rows: low + 2 * high
+        for (int w = 0; w < words; w++) {
+            uint64_t a = above ? above[w] : 0;
+            uint64_t b = middle[w];
+            uint64_t c = below ? below[w] : 0;
+            low[w] = a ^ b ^ c;
+            high[w] = (a & b) | (c & (a ^ b));
+        }
+
+        // Row sums of three column sums: bit0 + 2 * bit1 + 4 * bit2 + 8 * bit3
+        for (int w = 0; w < words; w++) {
+            uint64_t l = fromLeft(low.data(), w), m = low[w], n = fromRight(low.data(), w, words);
+            uint64_t h = fromLeft(high.data(), w), i = high[w], j = fromRight(high.data(), w, words);
+            uint64_t bit0 = l ^ m ^ n;
+            uint64_t carry = (l & m) | (n & (l ^ m));
+            uint64_t twos = h ^ i ^ j;
+            uint64_t fours = (h & i) | (j & (h ^ i));
+            uint64_t bit1 = twos ^ carry;
+            uint64_t carry4 = twos & carry;
+            uint64_t bit2 = fours ^ carry4;
+            uint64_t bit3 = fours & carry4;
+
+            uint64_t board = w + 1 < words ? ~uint64_t(0) : tail;
+            counts[0][begin + w] = bit0 & board;
+            counts[1][begin + w] = bit1 & board;
+            counts[2][begin + w] = bit2 & board;
+            counts[3][begin + w] = bit3 & board;
+            blank[begin + w] = ~(bit0 | bit1 | bit2 | bit3) & board;
+            uncoveredSafe += __builtin_popcountll(revealed[begin + w] & ~middle[w]);
+        }
+    }
+    safeHidden = static_cast<int>(size()) - mineCount - uncoveredSafe;
+}
+
+/**
+ * @brief Grows the opening of one row from the row next to it, then along its own blank runs.
+ *
+ * The opening of `from` is dilated by one column both ways and the covered blank cells it
+ * touches join the row. Each word that gained cells is filled on its own, towards both
+ * ends, so that the words do not wait on each other; a second pass carries the fill over
+ * word boundaries, which only a run crossing one needs.
+ *
+ * @param row The row to grow
+ * @param from The neighbouring row whose opening spreads into it, or -1 for none
+ * @return True if the opening of the row grew
+ */
+bool BitBoard::spreadRow(int row, int from) {
+    const size_t begin = static_cast<size_t>(row) * words;
+    uint64_t *line = &opening[begin];
+    const uint64_t *open = &blank[begin];
+    const uint64_t *shown = &revealed[begin];
+    const uint64_t *source = from >= 0 ? &opening[static_cast<size_t>(from) * words] : nullptr;
+    bool grew = false;
+
+    for (int w = 0; w < words; w++) {
+        uint64_t seed = line[w];
+        if (source) {
+            seed |= (source[w] | fromLeft(source, w) | fromRight(source, w, words)) & open[w] & ~shown[w];
+        }
+        if (seed != line[w] || !source) {
+            uint64_t pro = open[w] & ~shown[w];
+            line[w] = fillDown(fillUp(seed, pro), pro);
+            grew = true;
+        }
+    }
+    if (!grew || words == 1) {
+        return grew;
+    }
+
+    // Runs that cross a word boundary
+    for (int w = 1; w < words; w++) {
+        uint64_t pro = open[w] & ~shown[w];
+        if ((line[w - 1] >> 63) & pro & ~line[w] & 1) {
+            line[w] = fillUp(line[w] | 1, pro);
+        }
+    }
+    for (int w = words - 2; w >= 0; w--) {
+        uint64_t pro = open[w] & ~shown[w];
+        uint64_t high = uint64_t(1) << 63;
+        if ((line[w + 1] << 63) & pro & ~line[w] & high) {
+            line[w] = fillDown(line[w] | high, pro);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Uncovers a cell and, if it is blank, the opening around it.
+ *
+ * A numbered or mined cell is uncovered alone. From a blank cell, the opening is grown
+ * with spreadRow(), sweeping down and up between the rows that grew until a pair of
+ * sweeps changes nothing; the opening dilated by one cell is then uncovered and its
+ * flags removed, and the scratch plane is cleared over the rows it used.
+ *
+ * @param row The row of the cell
+ * @param col The column of the cell
+ * @return The number of cells uncovered, 0 if the cell is off the board or already revealed
+ */
+int BitBoard::reveal(int row, int col) {
+    if (!contains(row, col) || isRevealed(row, col)) {
+        return 0;
+    }
+    const size_t index = static_cast<size_t>(row) * words + (col >> 6);
+    const uint64_t bit = uint64_t(1) << (col & 63);
+    if (!(blank[index] & bit)) {
+        revealed[index] |= bit;
+        if (flagged[index] & bit) {
+            flagged[index] &= ~bit;
+            flags--;
+        }
+        safeHidden -= !(mines[index] & bit);
+        return 1;
+    }
+
+    // Grow the opening of covered blank cells, each row spreading to its neighbours only after it has grown
+    opening[index] = bit;
+    spreadRow(row, -1);
+    pushDown[row] = pushUp[row] = 1;
+    int top = row;
+    int bottom = row;
+    bool grew;
+    do {
+        for (int r = top + 1; r < rows; r++) {
+            if (!pushDown[r - 1]) {
+                if (r > bottom) {
+                    break;
+                }
+                continue;
+            }
+            pushDown[r - 1] = 0;
+            if (spreadRow(r, r - 1)) {
+                pushDown[r] = pushUp[r] = 1;
+                bottom = max(bottom, r);
+            }
+        }
+        grew = false;
+        for (int r = bottom - 1; r >= 0; r--) {
+            if (!pushUp[r + 1]) {
+                if (r < top) {
+                    break;
+                }
+                continue;
+            }
+            pushUp[r + 1] = 0;
+            if (spreadRow(r, r + 1)) {
+                pushDown[r] = pushUp[r] = 1;
+                top = min(top, r);
+                grew = true;
+            }
+        }
+    } while (grew);
+    fill(pushDown.begin() + top, pushDown.begin() + bottom + 1, 0);
+    fill(pushUp.begin() + top, pushUp.begin() + bottom + 1, 0);
+
+    // Uncover the opening and its border; blank cells have no mine next to them, so neither has the border
+    int uncovered = 0;
+    int unflagged = 0;
+    for (int r = max(top - 1, 0); r <= min(bottom + 1, rows - 1); r++) {
+        const size_t begin = static_cast<size_t>(r) * words;
+        for (int w = 0; w < words; w++) {
+            uint64_t reach = 0;
+            for (int n = max(r - 1, top); n <= min(r + 1, bottom); n++) {
+                const uint64_t *line = &opening[static_cast<size_t>(n) * words];
+                reach |= line[w] | fromLeft(line, w) | fromRight(line, w, words);
+            }
+            reach &= w + 1 < words ? ~uint64_t(0) : tail;
+            uint64_t fresh = reach & ~revealed[begin + w];
+            uncovered += __builtin_popcountll(fresh);
+            unflagged += __builtin_popcountll(fresh & flagged[begin + w]);
+            revealed[begin + w] |= fresh;
+            flagged[begin + w] &= ~fresh;
+        }
+    }
+    fill(opening.begin() + static_cast<size_t>(top) * words, opening.begin() + static_cast<size_t>(bottom + 1) * words, 0);
+
+    flags -= unflagged;
+    safeHidden -= uncovered;
+    return uncovered;
+}
+
+/**
+ * @brief Places a flag on a hidden cell or removes the flag from a flagged one; revealed cells are left alone.
+ * @param row The row of the cell
+ * @param col The column of the cell
+ */
+void BitBoard::toggleFlag(int row, int col) {
+    if (isRevealed(row, col)) {
+        return;
+    }
+    uint64_t &word = flagged[static_cast<size_t>(row) * words + (col >> 6)];
+    uint64_t bit = uint64_t(1) << (col & 63);
+    flags += word & bit ? -1 : 1;
+    word ^= bit;
+}
@@ -0,0 +1,165 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "board.h"
+
+/**
+ * @class BitBoard
+ * @brief A minesweeper board for large sizes, with the minefield and the player's view packed into bitplanes.
+ *
+ * Each plane keeps one bit per cell, a row being ceil(width / 64) uint64_t words with column c
+ * at bit c % 64 of word c / 64. The mines, the revealed cells and the flags each have a plane;
+ * the neighbour counts are stored bit-sliced in four more planes, so one word holds bit k of
+ * the counts of 64 cells. Counting and revealing work on whole words, 64 cells at a time,
+ * instead of one char per cell as in Board and GameBoard.
+ *
+ * A board starts without mines. Mines are placed with placeMine() and the board is made
+ * playable with countNeighbours(), which also sets the counts behind cleared().
+ */
+class BitBoard {
+public:
+    /**
+     * @brief Creates a board without mines, every cell hidden.
+     * @param width The number of columns
+     * @param height The number of rows
+     */
+    BitBoard(int width, int height);
+
+    /**
+     * @brief Creates a hidden board holding the mines of a char minefield.
+     * @param minefield The minefield, 'X' marking a mine
+     */
+    explicit BitBoard(const Board &minefield);
+
+    /** @brief Returns the number of columns. */
+    int width() const { return cols; }
+    /** @brief Returns the number of rows. */
+    int height() const { return rows; }
+    /** @brief Returns the number of cells, width() * height(). */
+    size_t size() const { return static_cast<size_t>(cols) * rows; }
+
+    /**
+     * @brief Checks whether a cell lies on the board.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     * @return True if 0 <= row < height() and 0 <= col < width()
+     */
+    bool contains(int row, int col) const { return row >= 0 && row < rows && col >= 0 && col < cols; }
+
+    /**
+     * @brief Checks whether a cell holds a mine.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    bool isMine(int row, int col) const { return test(mines, row, col); }
+    /**
+     * @brief Checks whether a cell has been uncovered.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    bool isRevealed(int row, int col) const { return test(revealed, row, col); }
+    /**
+     * @brief Checks whether a cell carries a flag.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    bool isFlagged(int row, int col) const { return test(flagged, row, col); }
+
+    /**
+     * @brief Returns a cell of the minefield: 'X' for a mine, '1' to '8' or ' '.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    char minefieldAt(int row, int col) const;
+
+    /**
+     * @brief Returns a cell as the player sees it: '#' hidden, 'F' flagged, otherwise minefieldAt().
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    char at(int row, int col) const;
+
+    /**
+     * @brief Removes every mine, flag and revealed cell.
+     */
+    void reset();
+
+    /**
+     * @brief Hides every cell again and removes the flags, keeping the minefield.
+     */
+    void cover();
+
+    /**
+     * @brief Puts a mine on a cell; countNeighbours() must run before the board is played.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    void placeMine(int row, int col);
+
+    /**
+     * @brief Computes the neighbour counts of every cell from the mine plane.
+     *
+     * For each row the mines of the row above, the row itself and the row below are added
+     * into a 2-bit column sum, and the sums of the column to the left, the column itself and
+     * the column to the right into the 4-bit count, all with bitwise adders on whole words.
+     * The cell's own mine is included, which changes nothing for the cells that show a count.
+     */
+    void countNeighbours();
+
+    /**
+     * @brief Uncovers a cell and, if it is blank, the opening around it.
+     *
+     * The opening is grown a row at a time over the plane of covered blank cells: each row
+     * takes the dilated opening of the row before it, then fills along its own runs of blank
+     * cells, 64 cells per step. Sweeps go down and up the board until one changes nothing,
+     * visiting only rows next to one that grew, and the opening dilated by one cell, which
+     * adds its numbered border, is uncovered.
+     *
+     * @param row The row of the cell
+     * @param col The column of the cell
+     * @return The number of cells uncovered
+     */
+    int reveal(int row, int col);
+
+    /**
+     * @brief Places a flag on a hidden cell or removes the flag from a flagged one.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    void toggleFlag(int row, int col);
+
+    /** @brief Returns true once every cell without a mine is uncovered. */
+    bool cleared() const { return safeHidden == 0; }
+    /** @brief Returns the number of cells without a mine that are still covered (hidden or flagged). */
+    int remainingSafe() const { return safeHidden; }
+    /** @brief Returns the number of mines minus the number of flags; negative if there are too many flags. */
+    int remainingMines() const { return mineCount - flags; }
+
+private:
+    bool test(const std::vector<uint64_t> &plane, int row, int col) const {
+        return (plane[static_cast<size_t>(row) * words + (col >> 6)] >> (col & 63)) & 1;
+    }
+
+    bool spreadRow(int row, int from);
+
+    int cols; /**< The number of columns */
+    int rows; /**< The number of rows */
+    int words; /**< The number of words per row of a plane */
+    uint64_t tail; /**< The bits of the last word of a row that lie on the board */
+    int mineCount = 0; /**< The number of mines */
+    int flags = 0; /**< The number of flags on the board */
+    int safeHidden = 0; /**< The number of covered cells without a mine */
+    std::vector<uint64_t> mines; /**< The mines */
+    std::vector<uint64_t> revealed; /**< The uncovered cells */
+    std::vector<uint64_t> flagged; /**< The flags */
+    std::vector<uint64_t> counts[4]; /**< Bit k of each cell's count of mines in its 3 x 3 block */
+    std::vector<uint64_t> blank; /**< Cells with no mine in their 3 x 3 block */
+    std::vector<uint64_t> opening; /**< Scratch plane of reveal(), all zero between calls */
+    std::vector<char> pushDown; /**< Rows of the opening that grew since they last spread to the row below */
+    std::vector<char> pushUp; /**< Rows of the opening that grew since they last spread to the row above */
+};
+
+#endif
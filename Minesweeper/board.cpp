@@ -0,0 +1,52 @@
+#include "board.h"
+
+using namespace std;
+
+/**
+ * @brief Creates a fully hidden board and counts the mines and safe cells of the minefield.
+ *
+ * @param minefield The minefield the board covers.
+ */
+GameBoard::GameBoard(const Board &minefield) : Board(minefield.width(), minefield.height(), '#') {
+    for (size_t i = 0; i < minefield.size(); i++) {
+        mines += minefield.data()[i] == 'X';
+    }
+    safeHidden = static_cast<int>(minefield.size()) - mines;
+}
+
+/**
+ * @brief Uncovers a cell with floodReveal() and updates the counts.
+ *
+ * Flags on the uncovered cells are removed, and every uncovered cell but a mine lowers the
+ * number of covered safe cells.
+ *
+ * @param minefield The minefield the board was created for.
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ * @param scratch Reusable buffers for the flood fill.
+ * @return The number of cells uncovered.
+ */
+int GameBoard::reveal(const Board &minefield, int row, int col, FloodScratch &scratch) {
+    FloodResult result = floodReveal(minefield.data(), data(), width(), height(), row, col, scratch);
+    flags -= result.unflagged;
+    // Only the clicked cell can be a mine: the fill spreads from blank cells, which have no mine next to them
+    safeHidden -= result.revealed - (result.revealed > 0 && minefield.at(row, col) == 'X');
+    return result.revealed;
+}
+
+/**
+ * @brief Flags a hidden cell or unflags a flagged one; an uncovered cell is left alone.
+ *
+ * @param row The row of the cell.
+ * @param col The column of the cell.
+ */
+void GameBoard::toggleFlag(int row, int col) {
+    char &cell = at(row, col);
+    if (cell == '#') {
+        cell = 'F';
+        flags++;
+    } else if (cell == 'F') {
+        cell = '#';
+        flags--;
+    }
+}
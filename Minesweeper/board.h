@@ -0,0 +1,110 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <cstddef>
+#include <vector>
+#include "floodfill.h"
+
+/**
+ * @class Board
+ * @brief A minesweeper grid with runtime dimensions, one char per cell in one row-major block.
+ *
+ * The same class holds both the minefield ('X' for a mine, '1' to '8' or ' ') and the board
+ * shown to the player ('#' hidden, 'F' flagged, otherwise the revealed minefield cell).
+ */
+class Board {
+public:
+    /**
+     * @param width The number of columns
+     * @param height The number of rows
+     * @param fill The initial value of every cell
+     */
+    Board(int width, int height, char fill = '#')
+        : cols(width), rows(height), cells(static_cast<size_t>(width) * height, fill) {}
+
+    /** @brief Returns the number of columns. */
+    int width() const { return cols; }
+    /** @brief Returns the number of rows. */
+    int height() const { return rows; }
+    /** @brief Returns the number of cells, width() * height(). */
+    size_t size() const { return cells.size(); }
+
+    /**
+     * @brief Checks whether a cell lies on the board.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     * @return True if 0 <= row < height() and 0 <= col < width()
+     */
+    bool contains(int row, int col) const { return row >= 0 && row < rows && col >= 0 && col < cols; }
+
+    /**
+     * @brief Returns a cell, unchecked.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    char &at(int row, int col) { return cells[static_cast<size_t>(row) * cols + col]; }
+    /**
+     * @brief Returns a cell, unchecked.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    char at(int row, int col) const { return cells[static_cast<size_t>(row) * cols + col]; }
+
+    /** @brief Returns the cells, row-major, for code that walks the whole board. */
+    char *data() { return cells.data(); }
+    /** @brief Returns the cells, row-major, for code that walks the whole board. */
+    const char *data() const { return cells.data(); }
+
+private:
+    int cols; /**< The number of columns */
+    int rows; /**< The number of rows */
+    std::vector<char> cells; /**< The cells, row-major */
+};
+
+/**
+ * @class GameBoard
+ * @brief The board shown to the player, with running counts that make win detection O(1).
+ *
+ * The counts are set up once, from the minefield or its mine count, and then updated by reveal() and
+ * toggleFlag(), the only two ways the player changes the board. Cells should not be
+ * written through at() directly, or the counts drift.
+ */
+class GameBoard : public Board {
+public:
+    /**
+     * @brief Creates a fully hidden board for a minefield.
+     * @param minefield The minefield the board covers
+     */
+    explicit GameBoard(const Board &minefield);
+
+    /**
+     * @brief Uncovers a cell and, if it is blank, the opening around it.
+     * @param minefield The minefield the board was created for
+     * @param row The row of the cell
+     * @param col The column of the cell
+     * @param scratch Reusable buffers for the flood fill
+     * @return The number of cells uncovered
+     */
+    int reveal(const Board &minefield, int row, int col, FloodScratch &scratch);
+
+    /**
+     * @brief Places a flag on a hidden cell or removes the flag from a flagged one.
+     * @param row The row of the cell
+     * @param col The column of the cell
+     */
+    void toggleFlag(int row, int col);
+
+    /** @brief Returns true once every cell without a mine is uncovered. */
+    bool cleared() const { return safeHidden == 0; }
+    /** @brief Returns the number of cells without a mine that are still covered (hidden or flagged). */
+    int remainingSafe() const { return safeHidden; }
+    /** @brief Returns the number of mines minus the number of flags; negative if there are too many flags. */
+    int remainingMines() const { return mines - flags; }
+
+private:
+    int mines = 0; /**< The number of mines in the minefield */
+    int flags = 0; /**< The number of flags on the board */
+    int safeHidden = 0; /**< The number of covered cells without a mine */
+};
+
+#endif
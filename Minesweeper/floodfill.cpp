@@ -0,0 +1,91 @@
+#include "floodfill.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Reveals a cell and, if it is blank, the whole opening around it.
+ *
+ * The fill is iterative: blank cells go onto an explicit stack instead of the call
+ * stack, and visited cells are marked in a flat bitmap, so each cell is looked at a
+ * constant number of times and the reveal is linear in the size of the opening. Both
+ * buffers live in `scratch` and keep their capacity between calls. The bitmap is
+ * all zero between calls: the words set during a reveal are listed in `scratch.touched`
+ * and cleared at its end, so a small reveal on a large board does not pay for the
+ * whole bitmap.
+ *
+ * Like the player would see it, every hidden or flagged cell reached is copied from the
+ * minefield to the board. Numbers and the edges of the board stop the spread; blank cells
+ * spread to all eight neighbours. Cells that are already revealed are skipped: a revealed
+ * blank cell had all its neighbours revealed with it, so nothing lies behind it.
+ *
+ * @param minefield The solution, row-major with width * height cells; ' ' marks a blank cell.
+ * @param board The board shown to the player, same layout; '#' hidden, 'F' flagged.
+ * @param width The number of columns of the board.
+ * @param height The number of rows of the board.
+ * @param row The row of the cell to reveal.
+ * @param col The column of the cell to reveal.
+ * @param scratch Reusable buffers for the fill.
+ * @return The number of cells uncovered and of flags removed on the way.
+ */
+FloodResult floodReveal(const char *minefield, char *board, int width, int height, int row, int col,
+                        FloodScratch &scratch) {
+    const size_t words = (static_cast<size_t>(width) * height + 63) / 64;
+    if (scratch.visited.size() != words) {
+        scratch.visited.assign(words, 0);
+    }
+    scratch.pending.clear();
+
+    auto visit = [&](int cell) {
+        uint64_t &word = scratch.visited[cell >> 6];
+        if (word == 0) {
+            scratch.touched.push_back(cell >> 6);
+        }
+        word |= uint64_t(1) << (cell & 63);
+    };
+
+    FloodResult result;
+    auto uncover = [&](int cell) {
+        if (board[cell] != '#' && board[cell] != 'F') {
+            return;
+        }
+        result.unflagged += board[cell] == 'F';
+        result.revealed++;
+        board[cell] = minefield[cell];
+        if (minefield[cell] == ' ') {
+            scratch.pending.push_back(cell);
+        }
+    };
+
+    int start = row * width + col;
+    visit(start);
+    uncover(start);
+
+    while (!scratch.pending.empty()) {
+        int cell = scratch.pending.back();
+        scratch.pending.pop_back();
+        int r = cell / width;
+        int c = cell % width;
+        int rowBegin = max(r - 1, 0);
+        int rowEnd = min(r + 1, height - 1);
+        int colBegin = max(c - 1, 0);
+        int colEnd = min(c + 1, width - 1);
+        for (int nr = rowBegin; nr <= rowEnd; nr++) {
+            for (int nc = colBegin; nc <= colEnd; nc++) {
+                int next = nr * width + nc;
+                uint64_t bit = uint64_t(1) << (next & 63);
+                if (scratch.visited[next >> 6] & bit) {
+                    continue;
+                }
+                visit(next);
+                uncover(next);
+            }
+        }
+    }
+
+    for (int word : scratch.touched) {
+        scratch.visited[word] = 0;
+    }
+    scratch.touched.clear();
+    return result;
+}
@@ -0,0 +1,29 @@
+#ifndef FLOODFILL_H
+#define FLOODFILL_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct FloodScratch
+ * @brief Buffers kept between reveals, so that a flood fill allocates nothing per cell.
+ */
+struct FloodScratch {
+    std::vector<uint64_t> visited; /**< One bit per cell, row-major */
+    std::vector<int> touched; /**< Indices of the words of visited set during the current reveal */
+    std::vector<int> pending; /**< Indices of the blank cells whose neighbours are still to be revealed */
+};
+
+/**
+ * @struct FloodResult
+ * @brief What one reveal changed on the board.
+ */
+struct FloodResult {
+    int revealed = 0; /**< Cells uncovered that were hidden or flagged before */
+    int unflagged = 0; /**< Flags removed because their cell was uncovered */
+};
+
+FloodResult floodReveal(const char *minefield, char *board, int width, int height, int row, int col,
+                        FloodScratch &scratch);
+
+#endif
@@ -1,7 +1,9 @@
 #include "minewseepergen.h"
+#include "floodfill.h"
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -13,21 +15,15 @@
 using namespace std;
 
 /**
- * @brief Loads the minefield configuration from a file into a 2D array.
+ * @brief Loads the minefield configuration from a file into a bit-packed board.
  *
- * This function reads the minefield configuration from the file located at
- * ".gameConfig/minefield.txt" and populates the provided 2D array `cord` with
- * the minefield data. Each element in the array represents a cell in the minefield.
+ * The file is the one saveMinefield() writes, ".gameConfig/minefield.txt". Only the mines
+ * are read; the numbers are recomputed by BitBoard::countNeighbours(). Every cell of the
+ * board ends up hidden.
  *
- * @param cord A 2D array of characters where the minefield configuration will be stored.
- *
- * @note The function assumes that the file ".gameConfig/minefield.txt" exists and is
- *       formatted correctly. If the file cannot be opened, the function will print
- *       an error message and terminate the program.
+ * @param cord The board where the minefield will be stored, already of the size of the minefield.
  */
-void loadMinefield(char cord[][MSIZE]) {
-    string minefield_stream;
-
+void loadMinefield(BitBoard &cord) {
     ifstream fin;
     noskipws(fin);
     fin.open(".gameConfig/minefield.txt");
@@ -37,13 +33,19 @@ void loadMinefield(char cord[][MSIZE]) {
         exit(1);
     };
 
+    cord.reset();
+    char cell;
     char newline;
-    for (int i = 0; i < MSIZE; i++) {
-        for (int j = 0; j < MSIZE; j++) {
-            fin >> cord[i][j];
+    for (int i = 0; i < cord.height(); i++) {
+        for (int j = 0; j < cord.width(); j++) {
+            fin >> cell;
+            if (cell == 'X') {
+                cord.placeMine(i, j);
+            }
         }
         fin >> newline;
     };
+    cord.countNeighbours();
 
     fin.close();
 }
@@ -53,33 +55,35 @@ void loadMinefield(char cord[][MSIZE]) {
  *
  * This function renders the Minesweeper game board on the screen using ncurses.
  * It highlights the current position of the cursor, flagged tiles, and mines.
- * Additionally, it displays the current coordinates, flag mode status, and a message.
+ * Additionally, it displays the current coordinates, flag mode status, the numbers of
+ * unflagged mines and covered safe tiles, and a message.
  *
- * @param cord A 2D array representing the Minesweeper game board.
+ * @param cord The Minesweeper game board.
  * @param posX The current X-coordinate of the cursor.
  * @param posY The current Y-coordinate of the cursor.
  * @param flagMode A boolean indicating whether the flag mode is active.
  * @param message A string containing a message to be displayed.
  */
-void display(char cord[][MSIZE], int posX, int posY, bool flagMode, string message) {
+void display(const GameBoard &cord, int posX, int posY, bool flagMode, string message) {
     move(0, 0);
-    for (int i = 0; i < MSIZE; i++) {
-        for (int j = 0; j < MSIZE; j++) {
-            if (cord[i][j] == 'X') {
+    for (int i = 0; i < cord.height(); i++) {
+        for (int j = 0; j < cord.width(); j++) {
+            char cell = cord.at(i, j);
+            if (cell == 'X') {
                 attron(COLOR_PAIR(3));
-                addch(cord[i][j]);
+                addch(cell);
                 attroff(COLOR_PAIR(3));
-            } else if (cord[i][j] == 'F') {
+            } else if (cell == 'F') {
                 attron(COLOR_PAIR(4));
-                addch(cord[i][j]);
+                addch(cell);
                 attroff(COLOR_PAIR(4));
             } else if (i == posY && j == posX) {
                 attron(COLOR_PAIR(2));
-                addch(cord[i][j]);
+                addch(cell);
                 attroff(COLOR_PAIR(2));
             } else {
                 attron(COLOR_PAIR(1));
-                addch(cord[i][j]);
+                addch(cell);
                 attroff(COLOR_PAIR(1));
             }
         };
@@ -87,6 +91,8 @@ void display(char cord[][MSIZE], int posX, int posY, bool flagMode, string messa
     };
     printw("Current coordinates: %d %d %s", posX, posY, flagMode ? "(flag ON)" : "(flag OFF)");
     printw("\n");
+    printw("Mines left: %d  Safe tiles left: %d", cord.remainingMines(), cord.remainingSafe());
+    printw("\n");
     if (message == "")
         printw("Use spacebar to select tile, 'f' to flag");
     else {
@@ -95,21 +101,6 @@ void display(char cord[][MSIZE], int posX, int posY, bool flagMode, string messa
     refresh();
 }
 
-/**
- * @brief Initializes the game board for Minesweeper.
- * 
- * This function sets up the game board by filling each cell with the character '#'.
- * 
- * @param cord A 2D array representing the game board.
- */
-void initGameBoard(char cord[][MSIZE]) {
-    for (int r = 0; r < MSIZE; r++) {
-        for (int c = 0; c < MSIZE; c++) {
-            cord[r][c] = '#';
-        }
-    }
-}
-
 /**
  * @brief Checks if a cell in the Minesweeper grid has been revealed.
  * 
@@ -117,68 +108,64 @@ void initGameBoard(char cord[][MSIZE]) {
  * has been revealed by checking its character value. A cell is considered
  * revealed if it does not contain a '#' (hidden cell) or 'F' (flagged cell).
  * 
- * @param cord The Minesweeper grid represented as a 2D array of characters.
+ * @param cord The Minesweeper grid.
  * @param row The row index of the cell to check.
  * @param col The column index of the cell to check.
  * @return true If the cell is revealed.
  * @return false If the cell is hidden or flagged.
  */
-bool checkIfRevealed(char cord[][MSIZE], int row, int col) {
-    return cord[row][col] != '#' && cord[row][col] != 'F';
+bool checkIfRevealed(const Board &cord, int row, int col) {
+    return cord.at(row, col) != '#' && cord.at(row, col) != 'F';
 }
 
 /**
- * @brief Reveals the position on the game board and recursively reveals adjacent positions if they are empty.
+ * @brief Reveals the position on the game board and, if it is empty, the opening around it.
  * 
  * This function updates the game board by revealing the content of the specified position. If the revealed position
- * is empty (represented by a space character ' '), it recursively reveals all adjacent positions. The function also
- * keeps track of visited positions to avoid infinite recursion.
+ * is empty (represented by a space character ' '), all connected empty positions and their numbered borders are
+ * revealed as well. The work is done by floodReveal(), which fills iteratively with a visited bitmap, and the
+ * counts of the game board are updated on the way.
  * 
  * @param cord The original board containing the actual positions and their values.
  * @param gameBoard The game board that is being revealed to the player.
  * @param row The row index of the position to reveal.
  * @param col The column index of the position to reveal.
- * @param visited A reference to a vector of vectors that keeps track of visited positions to avoid revisiting them.
- * @return true if the position was successfully revealed and it was not a mine, false otherwise.
+ * @param scratch The buffers of the flood fill, reused from one reveal to the next.
+ * @return true if the position was revealed and it was not a mine, false otherwise.
  */
-bool revealPos(char cord[][MSIZE], char gameBoard[][MSIZE], int row, int col, vector<vector<int>> &visited) {
-    if (std::find(visited.begin(), visited.end(), vector<int>{row, col}) ==
-        visited.end()) {
-        visited.push_back(vector<int>{row, col});
-        gameBoard[row][col] = cord[row][col];
-        if (cord[row][col] != ' ') {
-            return false;
-        }
-        for (vector<int> spread : vector<vector<int>>{
-			{row - 1, col - 1},
-            {row - 1, col},
-            {row - 1, col + 1},
-            {row, col - 1},
-            {row, col + 1},
-            {row + 1, col - 1},
-            {row + 1, col},
-            {row + 1, col + 1}}) {
-            if (spread[0] >= 0 && spread[0] < MSIZE && spread[1] >= 0 && spread[1] < MSIZE) {
-                revealPos(cord, gameBoard, spread[0], spread[1], visited);
-            }
-        }
-    }
-    return false;
+bool revealPos(const Board &cord, GameBoard &gameBoard, int row, int col, FloodScratch &scratch) {
+    gameBoard.reveal(cord, row, col, scratch);
+    return cord.at(row, col) != 'X';
+}
+
+/**
+ * @brief Reveals the position on a bit-packed board and, if it is empty, the opening around it.
+ *
+ * The opening is found by BitBoard::reveal(), which grows it a row of words at a time.
+ *
+ * @param board The board, holding both the minefield and what the player has revealed.
+ * @param row The row index of the position to reveal.
+ * @param col The column index of the position to reveal.
+ * @return true if the position was revealed and it was not a mine, false otherwise.
+ */
+bool revealPos(BitBoard &board, int row, int col) {
+    board.reveal(row, col);
+    return !board.isMine(row, col);
 }
 
 /**
  * @brief Checks if a mine is found at the specified coordinates.
  *
- * This function checks the given 2D array of characters to determine if there is a mine ('X')
+ * This function checks the given board to determine if there is a mine ('X')
  * at the specified row and column.
  *
- * @param cord A 2D array of characters representing the game board.
+ * @param cord The minefield.
  * @param row The row index to check.
  * @param col The column index to check.
  * @return true if a mine is found at the specified coordinates, false otherwise.
  */
-bool checkIfMineFound(char cord[][MSIZE], int row, int col) {
-    return cord[row][col] == 'X';
+bool checkIfMineFound(const Board &cord, int row, int col) {
+    return cord.at(row, col) == 'X';
 }
 
 /**
@@ -186,38 +173,65 @@ bool checkIfMineFound(char cord[][MSIZE], int row, int col) {
  *
  * This function places a flag ('F') at the given row and column if the cell is currently unmarked ('#').
  * If the cell already has a flag ('F'), it removes the flag and reverts the cell back to unmarked ('#').
+ * The game board keeps its flag count up to date.
  *
- * @param cord The Minesweeper board represented as a 2D array of characters.
+ * @param cord The Minesweeper board.
  * @param row The row index of the cell to place or remove the flag.
  * @param col The column index of the cell to place or remove the flag.
  */
-void placeFlag(char cord[][MSIZE], int row, int col) {
-    if (cord[row][col] == '#') {
-        cord[row][col] = 'F';
-    } else if (cord[row][col] == 'F') {
-        cord[row][col] = '#';
-    }
+void placeFlag(GameBoard &cord, int row, int col) {
+    cord.toggleFlag(row, col);
 }
 
 /**
- * @brief Checks if the game is won by verifying if all cells are revealed.
+ * @brief Checks if the game is won, i.e. every tile without a mine is revealed.
  *
- * This function iterates through the entire game board and checks if there are any cells
- * that are still hidden (represented by the character '#'). If any hidden cell is found,
- * the game is not won yet.
+ * The game board counts its covered safe tiles as they are revealed, so this is a
+ * constant-time lookup rather than a scan of the board.
  *
- * @param cord A 2D array representing the game board.
- * @return true if all cells are revealed and the game is won, false otherwise.
+ * @param cord The game board.
+ * @return true if all safe tiles are revealed and the game is won, false otherwise.
  */
-bool checkIfGameWin(char cord[][MSIZE]) {
-    for (int r = 0; r < MSIZE; r++) {
-        for (int c = 0; c < MSIZE; c++) {
-            if (cord[r][c] == '#') {
-                return false;
-            }
-        }
+bool checkIfGameWin(const GameBoard &cord) {
+    return cord.cleared();
+}
+
+/**
+ * @brief Checks if the game on a bit-packed board is won, in constant time like checkIfGameWin(const GameBoard &).
+ *
+ * @param cord The board.
+ * @return true if all safe tiles are revealed and the game is won, false otherwise.
+ */
+bool checkIfGameWin(const BitBoard &cord) {
+    return cord.cleared();
+}
+
+/**
+ * @brief Chooses the side length of the minesweeper board for an encounter in the maze.
+ *
+ * The board grows linearly from MSIZE at the entrance to MSIZE_MAX at the exit, so
+ * encounters get harder the further the player has come.
+ *
+ * @param row The maze row where the player met the monster.
+ * @param height The number of rows of the maze.
+ * @return The side length of the board.
+ */
+int encounterBoardSize(int row, int height) {
+    if (height <= 1) {
+        return MSIZE;
     }
-    return true;
+    row = max(0, min(row, height - 1));
+    return MSIZE + (MSIZE_MAX - MSIZE) * row / (height - 1);
+}
+
+/**
+ * @brief Returns the number of mines for a board, at the density of the default board.
+ *
+ * @param size The side length of the board.
+ * @return MINES scaled by the area of the board.
+ */
+int encounterMines(int size) {
+    return static_cast<int>(static_cast<long>(MINES) * size * size / (MSIZE * MSIZE));
 }
 
 /**
@@ -227,24 +241,28 @@ bool checkIfGameWin(char cord[][MSIZE]) {
  * The player can navigate the game board using 'w', 'a', 's', 'd' keys and can reveal tiles
  * or place flags using the space bar and 'f' key respectively. The game continues until the
  * player either wins by revealing all non-mine tiles or loses by revealing a mine.
+ *
+ * The minefield comes ready-made, with no mine on the centre tile or around it, and the
+ * game opens by revealing the centre, so the first frame already shows a blank area and
+ * the game never ends on the first move.
  * 
+ * @param mf The minefield, safe around (height / 2, width / 2), as given by MinefieldPool.
+ * @param firstFrame Receives the time at which the first frame was on screen, if not null. It is
+ *        set on every path, also when the opening reveal alone clears the board.
  * @return int Returns 0 if the player wins, and -1 if the player loses.
  */
-int minesweeper() {
-    minewsweepergenmain();
+int minesweeper(const Board &mf, chrono::steady_clock::time_point *firstFrame) {
     char usrInput{};
-    int posX = 0;
-    int posY = 0;
-    char mf[MSIZE][MSIZE];
-    loadMinefield(mf);
-
-    char gameBoard[MSIZE][MSIZE];
-    initGameBoard(gameBoard);
+    int posX = mf.width() / 2;
+    int posY = mf.height() / 2;
+    GameBoard gameBoard(mf);
+    FloodScratch scratch;
+    revealPos(mf, gameBoard, posY, posX, scratch);
 
     bool gameLose = false;
     string str_in, errorMsg;
     int row_in, col_in;
-    bool flagMode;
+    bool flagMode = false;
     bool act;
     while (!checkIfGameWin(gameBoard)) {
         flagMode = false;
@@ -253,6 +271,10 @@ int minesweeper() {
         refresh();
         while (!act) {
             display(gameBoard, posX, posY, flagMode, errorMsg);
+            if (firstFrame != nullptr) {
+                *firstFrame = chrono::steady_clock::now();
+                firstFrame = nullptr;
+            }
             usrInput = getch();
             switch (usrInput) {
                 case 'w':
@@ -261,7 +283,7 @@ int minesweeper() {
                     }
                     break;
                 case 's':
-                    if (posY + 1 < MSIZE) {
+                    if (posY + 1 < gameBoard.height()) {
                         posY++;
                     }
                     break;
@@ -271,7 +293,7 @@ int minesweeper() {
                     }
                     break;
                 case 'd':
-                    if (posX + 1 < MSIZE) {
+                    if (posX + 1 < gameBoard.width()) {
                         posX++;
                     }
                     break;
@@ -295,8 +317,7 @@ int minesweeper() {
             if (checkIfRevealed(gameBoard, row_in, col_in)) {
                 errorMsg = "Tile was already revealed. Please choose another one.";
             } else {
-                vector<vector<int>> visited{};
-                revealPos(mf, gameBoard, row_in, col_in, visited);
+                revealPos(mf, gameBoard, row_in, col_in, scratch);
 
                 if (checkIfMineFound(mf, row_in, col_in)) {
                     gameLose = true;
@@ -309,5 +330,8 @@ int minesweeper() {
     clear();
     refresh();
     display(gameBoard, posX, posY, flagMode, "Cleared!");
+    if (firstFrame != nullptr) {
+        *firstFrame = chrono::steady_clock::now(); // The opening reveal cleared the board
+    }
     return 0;
 }
\ No newline at end of file
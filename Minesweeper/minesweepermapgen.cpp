@@ -2,116 +2,150 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
-#include <ctime>
+#include <algorithm>
+#include <random>
+#include <vector>
 using namespace std;
 
-// void minefieldgen(int size, int mines, char cord[][MSIZE]);
-// int randcord(int size);
-// bool checkismine(int x, int y, int size, char cord[][MSIZE]);
-// int countmine(int x, int y, int size, char cord[][MSIZE]);
-
 /**
  * @brief Generates a random coordinate within the given size.
  * 
  * This function returns a random integer between 0 (inclusive) and the specified size (exclusive).
- * It uses the standard library function rand() to generate the random number.
+ * It takes the raw output of the seeded engine, so the same seed always gives the same minefield.
  * 
+ * @param rng The random engine of the minefield.
  * @param size The upper limit (exclusive) for the random coordinate.
  * @return int A random integer between 0 and size-1.
  */
-int randcord(int size) {
-    return rand() % size;
+int randcord(mt19937_64 &rng, int size) {
+    return static_cast<int>(rng() % size);
 }
 
 /**
- * @brief Counts the number of mines surrounding a given cell in a Minesweeper grid.
+ * @brief Generates a minesweeper minefield.
+ *
+ * This function clears the board, randomly places the specified number of mines and
+ * calculates the number of adjacent mines for each cell. The size of the minefield is
+ * the size of the board.
  *
- * This function checks the eight neighboring cells around the specified cell (x, y)
- * in the Minesweeper grid and counts how many of them contain a mine ('X').
+ * @param cord The board that receives the minefield.
+ * @param mines The number of mines to place in the minefield.
+ * @param rng The random engine used to place the mines.
+ * @param safeRow The row of the first revealed cell, or -1 to place mines anywhere.
+ * @param safeCol The column of the first revealed cell.
+ *
+ * The function performs the following steps:
+ * 1. Lists the index of every cell outside the 3 x 3 block around (safeRow, safeCol), so
+ *    the first revealed cell is always blank.
+ * 2. Picks the mines with a partial Fisher-Yates shuffle of that list: the first `mines`
+ *    entries are swapped with a random later entry, one engine draw per mine and no retries.
+ * 3. Adds one to every neighbour of each mine that is not itself a mine, then turns the
+ *    cells without a neighbouring mine from '0' into ' '.
  *
- * @param x The x-coordinate of the cell to check.
- * @param y The y-coordinate of the cell to check.
- * @param size The size of the Minesweeper grid.
- * @param cord A 2D array representing the Minesweeper grid, where 'X' denotes a mine.
- * @return The number of mines surrounding the specified cell.
+ * Note:
+ * - The number of mines is capped at the number of cells outside the safe block.
+ * - The function uses a helper function `randcord(mt19937_64 &, int)` to pick the mines.
  */
-int countmine(int x, int y, int size, char cord[][MSIZE]) {
-    int mines = 0;
+void minefieldgen(Board &cord, int mines, mt19937_64 &rng, int safeRow, int safeCol) {
+    const int width = cord.width();
+    const int height = cord.height();
+    char *cells = cord.data();
+    fill(cells, cells + cord.size(), '0');
 
-    for (int i = -1; i <= 1; ++i) {
-        for (int j = -1; j <= 1; ++j) {
-            if (i == 0 && j == 0) {
-                continue;
-            }
-            int newX = x + i;
-            int newY = y + j;
-            if (newX >= 0 && newX < size && newY >= 0 && newY < size && cord[newX][newY] == 'X') {
-                mines += 1;
+    vector<int> candidates;
+    candidates.reserve(cord.size());
+    for (int i = 0; i < height; ++i) {
+        for (int j = 0; j < width; ++j) {
+            if (safeRow < 0 || abs(i - safeRow) > 1 || abs(j - safeCol) > 1) {
+                candidates.push_back(i * width + j);
             }
         }
     }
 
-    return mines;
+    mines = min(mines, static_cast<int>(candidates.size()));
+    for (int m = 0; m < mines; ++m) {
+        swap(candidates[m], candidates[m + randcord(rng, static_cast<int>(candidates.size()) - m)]);
+        cells[candidates[m]] = 'X';
+    }
+
+    for (int m = 0; m < mines; ++m) {
+        int x = candidates[m] / width;
+        int y = candidates[m] % width;
+        for (int i = max(x - 1, 0); i <= min(x + 1, height - 1); ++i) {
+            for (int j = max(y - 1, 0); j <= min(y + 1, width - 1); ++j) {
+                char &cell = cells[i * width + j];
+                if (cell != 'X') {
+                    ++cell;
+                }
+            }
+        }
+    }
+    replace(cells, cells + cord.size(), '0', ' ');
 }
 
 /**
- * @brief Generates a minesweeper minefield and writes it to a file.
+ * @brief Generates a minesweeper minefield on a bit-packed board.
  *
- * This function initializes a minefield of given size, randomly places a specified number of mines,
- * calculates the number of adjacent mines for each cell, and writes the resulting minefield to a file.
+ * The board is too large for a list of every cell index, so the mines are chosen with
+ * Floyd's sampling instead of a shuffle: for each of the last `mines` candidate indices j
+ * a random index up to j is drawn, and j itself is taken if the drawn one already holds a
+ * mine. That is one engine draw per mine and no retries, with the mine plane as the set
+ * of chosen cells. The counts are then added up a row of words at a time by countNeighbours().
  *
- * @param size The size of the minefield (size x size).
+ * @param cord The board that receives the minefield; it is reset first.
  * @param mines The number of mines to place in the minefield.
- * @param cord A 2D array representing the minefield.
- *
- * The function performs the following steps:
- * 1. Initializes all cells in the minefield to empty (' ').
- * 2. Randomly places the specified number of mines ('X') in the minefield.
- * 3. For each non-mine cell, calculates the number of adjacent mines and sets the cell to that number.
- * 4. Writes the resulting minefield to a file named ".gameConfig/minefield.txt".
- *
- * Note:
- * - The function assumes that the size of the 2D array `cord` is at least `size x size`.
- * - The function uses a helper function `randcord(int)` to generate random coordinates.
- * - The function uses a helper function `countmine(int, int, int, char[][MSIZE])` to count adjacent mines.
+ * @param rng The random engine used to place the mines.
+ * @param safeRow The row of the first revealed cell, or -1 to place mines anywhere.
+ * @param safeCol The column of the first revealed cell.
  */
-void minefieldgen(int size, int mines, char cord[][MSIZE]) {
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            cord[i][j] = ' ';
-        }
-    }
-
-    for (int m = 0; m < mines; ++m) {
-        int x = randcord(MSIZE);
-        int y = randcord(MSIZE);
+void minefieldgen(BitBoard &cord, int mines, mt19937_64 &rng, int safeRow, int safeCol) {
+    const int width = cord.width();
+    cord.reset();
 
-        if (cord[x][y] == ' ' && x != 0 && y != 0) {
-            cord[x][y] = 'X';
-        } else {
-            --m;
+    // Candidate indices skip the safe block, whose cells are listed in increasing order
+    int safe[9];
+    int safeCells = 0;
+    for (int i = safeRow - 1; safeRow >= 0 && i <= safeRow + 1; ++i) {
+        for (int j = safeCol - 1; j <= safeCol + 1; ++j) {
+            if (cord.contains(i, j)) {
+                safe[safeCells++] = i * width + j;
+            }
         }
     }
+    auto cellOf = [&](int candidate) {
+        for (int k = 0; k < safeCells && safe[k] <= candidate; ++k) {
+            ++candidate;
+        }
+        return candidate;
+    };
 
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            if (cord[i][j] != 'X') {
-                int nummine = countmine(i, j, size, cord);
-                if (nummine > 0)
-                    cord[i][j] = '0' + nummine;
-            }
+    const int candidates = static_cast<int>(cord.size()) - safeCells;
+    mines = min(mines, candidates);
+    for (int j = candidates - mines; j < candidates; ++j) {
+        int cell = cellOf(randcord(rng, j + 1));
+        if (cord.isMine(cell / width, cell % width)) {
+            cell = cellOf(j);
         }
+        cord.placeMine(cell / width, cell % width);
     }
+    cord.countNeighbours();
+}
 
+/**
+ * @brief Writes a minefield to ".gameConfig/minefield.txt", one line per row.
+ *
+ * @param cord The minefield to write.
+ */
+void saveMinefield(const Board &cord) {
     ofstream fout(".gameConfig/minefield.txt");
     if (fout.fail()) {
         cout << "error opening minefield.txt" << endl;
         exit(1);
     }
 
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            fout << cord[i][j];
+    for (int i = 0; i < cord.height(); ++i) {
+        for (int j = 0; j < cord.width(); ++j) {
+            fout << cord.at(i, j);
         }
         fout << endl;
     }
@@ -119,16 +153,34 @@ void minefieldgen(int size, int mines, char cord[][MSIZE]) {
     fout.close();
 }
 
+/**
+ * @brief Generates a minefield in memory from a seed.
+ *
+ * @param seed The seed of the minefield; the same seed and first cell give the same minefield.
+ * @param size The side length of the minefield.
+ * @param mines The number of mines to place.
+ * @param safeRow The row of the first revealed cell, or -1 to place mines anywhere.
+ * @param safeCol The column of the first revealed cell.
+ * @return The minefield.
+ */
+Board generateMinefield(uint64_t seed, int size, int mines, int safeRow, int safeCol) {
+    mt19937_64 rng(seed);
+    Board cord(size, size);
+
+    minefieldgen(cord, mines, rng, safeRow, safeCol);
+    return cord;
+}
+
 /**
  * @brief Main function to generate a Minesweeper game map.
  * 
- * This function initializes the random number generator with the current time,
- * creates a 2D array to represent the Minesweeper grid, and calls the 
- * minefieldgen function to populate the grid with mines.
+ * This function generates a size x size minefield with generateMinefield and writes it
+ * to ".gameConfig/minefield.txt".
+ *
+ * @param seed The seed of the minefield; the same seed gives the same minefield.
+ * @param size The side length of the minefield.
+ * @param mines The number of mines to place.
  */
-void minewsweepergenmain() {
-    srand(time(NULL));
-    char cord[MSIZE][MSIZE];
-
-    minefieldgen(MSIZE, MINES, cord);
+void minewsweepergenmain(uint64_t seed, int size, int mines) {
+    saveMinefield(generateMinefield(seed, size, mines));
 }
\ No newline at end of file
@@ -2,7 +2,15 @@
 #define MINEWSEEPGEN_H
 
 #include "ms_config.h"
+#include "board.h"
+#include "bitboard.h"
+#include <cstdint>
+#include <random>
 
-void minewsweepergenmain();
+void minefieldgen(Board &cord, int mines, std::mt19937_64 &rng, int safeRow = -1, int safeCol = -1);
+void minefieldgen(BitBoard &cord, int mines, std::mt19937_64 &rng, int safeRow = -1, int safeCol = -1);
+Board generateMinefield(uint64_t seed, int size = MSIZE, int mines = MINES, int safeRow = -1, int safeCol = -1);
+void saveMinefield(const Board &cord);
+void minewsweepergenmain(uint64_t seed, int size = MSIZE, int mines = MINES);
 
 #endif
\ No newline at end of file
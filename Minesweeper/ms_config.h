@@ -1,7 +1,8 @@
 #ifndef MINESWEEPER_CONFIG_H
 #define MINESWEEPER_CONFIG_H
 
-#define MSIZE 15
-#define MINES 20
+#define MSIZE 15 // Side length of the default board, used at the maze entrance
+#define MINES 20 // Mines on the default board; larger boards keep the same density
+#define MSIZE_MAX 25 // Side length of the board met next to the maze exit
 
 #endif
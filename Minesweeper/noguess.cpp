@@ -0,0 +1,77 @@
+#include "noguess.h"
+#include "minewseepergen.h"
+#include "solver.h"
+#include "threadPool.h"
+#include <atomic>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Returns the seed of one candidate board; candidate 0 uses the seed itself.
+ * @param seed The seed of the minefield
+ * @param attempt The number of the candidate
+ */
+static uint64_t candidateSeed(uint64_t seed, int attempt) {
+    return seed + static_cast<uint64_t>(attempt) * 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * @brief Generates a minefield that can be cleared from the first click without guessing.
+ *
+ * Candidate boards are generated with minefieldgen() around the first click and played
+ * by MinesweeperSolver with guessing turned off; the first one it clears is kept. The
+ * candidates are spread over `threads` workers with parallelFor(). Once a candidate is
+ * cleared, the workers skip every later one, but the earlier ones still in flight are
+ * finished, so the board kept is always the lowest cleared candidate and does not depend
+ * on the number of threads. Candidate 0 is the board generateMinefield() would give, so
+ * boards that need no guess anyway are unchanged.
+ *
+ * If none of NOGUESS_MAX_ATTEMPTS candidates is cleared, candidate 0 is kept.
+ *
+ * @param seed The seed of the minefield; the same seed and first click give the same minefield.
+ * @param size The side length of the minefield.
+ * @param mines The number of mines to place.
+ * @param safeRow The row of the first click.
+ * @param safeCol The column of the first click.
+ * @param threads The number of worker threads; values below 1 mean one per hardware thread.
+ * @param stats Receives the number of candidates tried and whether one was cleared, if not null.
+ * @return The minefield.
+ */
+Board generateNoGuessMinefield(uint64_t seed, int size, int mines, int safeRow, int safeCol, int threads,
+                               NoGuessStats *stats) {
+    if (threads < 1) {
+        threads = defaultThreadCount();
+    }
+    threads = min(threads, NOGUESS_MAX_ATTEMPTS);
+    vector<MinesweeperSolver> solvers(threads);
+    vector<Board> candidates(threads, Board(size, size));
+    atomic<int> accepted{NOGUESS_MAX_ATTEMPTS};
+
+    parallelFor(NOGUESS_MAX_ATTEMPTS, threads, [&](int attempt, int worker) {
+        if (attempt > accepted.load(memory_order_relaxed)) {
+            return; // An earlier candidate has already been cleared
+        }
+        mt19937_64 rng(candidateSeed(seed, attempt));
+        minefieldgen(candidates[worker], mines, rng, safeRow, safeCol);
+        GameBoard board(candidates[worker]);
+        SolveResult result = solvers[worker].play(candidates[worker], board, safeRow, safeCol, rng, false);
+        if (result.outcome != SolveOutcome::Cleared) {
+            return;
+        }
+        int current = accepted.load(memory_order_relaxed);
+        while (attempt < current && !accepted.compare_exchange_weak(current, attempt, memory_order_relaxed)) {
+        }
+    });
+
+    bool solved = accepted < NOGUESS_MAX_ATTEMPTS;
+    if (stats != nullptr) {
+        stats->attempts = solved ? accepted + 1 : NOGUESS_MAX_ATTEMPTS;
+        stats->solved = solved;
+    }
+    mt19937_64 rng(candidateSeed(seed, solved ? accepted.load() : 0));
+    Board cord(size, size);
+    minefieldgen(cord, mines, rng, safeRow, safeCol);
+    return cord;
+}
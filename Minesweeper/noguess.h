@@ -0,0 +1,21 @@
+#ifndef NOGUESS_H
+#define NOGUESS_H
+
+#include "board.h"
+#include <cstdint>
+
+#define NOGUESS_MAX_ATTEMPTS 1000 // Candidate boards tried before no-guess generation gives up and keeps an ordinary one
+
+/**
+ * @struct NoGuessStats
+ * @brief What one no-guess generation took.
+ */
+struct NoGuessStats {
+    int attempts = 0; /**< Candidate boards up to and including the accepted one */
+    bool solved = false; /**< False if no candidate could be cleared without guessing */
+};
+
+Board generateNoGuessMinefield(uint64_t seed, int size, int mines, int safeRow, int safeCol, int threads = 1,
+                               NoGuessStats *stats = nullptr);
+
+#endif
@@ -0,0 +1,273 @@
+#include "solver.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Collects the hidden neighbours of a revealed number and the mines left among them.
+ * @param board The board shown to the player
+ * @param row The row of the number
+ * @param col The column of the number
+ * @param constraint Receives the cells and the mines
+ * @return True if the cell is a number with at least one hidden unflagged neighbour
+ */
+bool MinesweeperSolver::constrain(const GameBoard &board, int row, int col, Constraint &constraint) const {
+    char value = board.at(row, col);
+    if (value < '1' || value > '8') {
+        return false;
+    }
+    int flags = 0;
+    constraint.cell = row * board.width() + col;
+    constraint.count = 0;
+    for (int r = max(row - 1, 0); r <= min(row + 1, board.height() - 1); r++) {
+        for (int c = max(col - 1, 0); c <= min(col + 1, board.width() - 1); c++) {
+            char cell = board.at(r, c);
+            if (cell == 'F') {
+                flags++;
+            } else if (cell == '#') {
+                constraint.cells[constraint.count++] = r * board.width() + c;
+            }
+        }
+    }
+    constraint.mines = value - '0' - flags;
+    return constraint.count > 0;
+}
+
+/**
+ * @brief Adds the numbers revealed since the last call to the frontier.
+ *
+ * The board is compared with the copy taken at the last call, a plain pass over the
+ * cells, which is cheaper than asking every cell for its constraint again.
+ *
+ * @param board The board shown to the player
+ */
+void MinesweeperSolver::collectNumbers(const GameBoard &board) {
+    const char *cells = board.data();
+    for (size_t i = 0; i < board.size(); i++) {
+        if (cells[i] != seen[i]) {
+            seen[i] = cells[i];
+            if (cells[i] >= '1' && cells[i] <= '8') {
+                frontier.push_back(static_cast<int>(i));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Applies the single-cell rules to every number of the frontier.
+ * @param minefield The minefield, for the reveals
+ * @param board The board shown to the player
+ * @param result Counts the moves made
+ * @return True if a cell was revealed or flagged
+ */
+bool MinesweeperSolver::applySingleRules(const Board &minefield, GameBoard &board, SolveResult &result) {
+    const int width = board.width();
+    bool progress = false;
+    Constraint constraint;
+    collectNumbers(board);
+    for (size_t k = 0; k < frontier.size();) {
+        if (!constrain(board, frontier[k] / width, frontier[k] % width, constraint)) {
+            // No hidden neighbours left: the number has nothing more to tell
+            frontier[k] = frontier.back();
+            frontier.pop_back();
+            continue;
+        }
+        if (constraint.mines == 0) {
+            for (int i = 0; i < constraint.count; i++) {
+                board.reveal(minefield, constraint.cells[i] / width, constraint.cells[i] % width, scratch);
+                result.moves++;
+            }
+            progress = true;
+        } else if (constraint.mines == constraint.count) {
+            for (int i = 0; i < constraint.count; i++) {
+                board.toggleFlag(constraint.cells[i] / width, constraint.cells[i] % width);
+                result.moves++;
+            }
+            progress = true;
+        }
+        k++;
+    }
+    return progress;
+}
+
+/**
+ * @brief Applies the subset rule to pairs of numbers at most two cells apart.
+ *
+ * The constraints of the turn are kept in `constraints` and `constraintAt` afterwards,
+ * where chooseGuess() reads them. A deduction stays true as the board changes, so every
+ * one found in the pass is applied, skipping cells that are no longer hidden.
+ *
+ * @param minefield The minefield, for the reveals
+ * @param board The board shown to the player
+ * @param result Counts the moves made
+ * @return True if a cell was revealed or flagged
+ */
+bool MinesweeperSolver::applySubsetRules(const Board &minefield, GameBoard &board, SolveResult &result) {
+    const int width = board.width();
+    for (const Constraint &constraint : constraints) {
+        constraintAt[constraint.cell] = -1;
+    }
+    constraints.clear();
+    Constraint constraint;
+    collectNumbers(board);
+    for (int cell : frontier) {
+        if (constrain(board, cell / width, cell % width, constraint)) {
+            constraintAt[cell] = static_cast<int>(constraints.size());
+            constraints.push_back(constraint);
+        }
+    }
+
+    bool progress = false;
+    for (const Constraint &inner : constraints) {
+        int row = inner.cell / width;
+        int col = inner.cell % width;
+        for (int r = max(row - 2, 0); r <= min(row + 2, board.height() - 1); r++) {
+            for (int c = max(col - 2, 0); c <= min(col + 2, width - 1); c++) {
+                int index = constraintAt[r * width + c];
+                if (index < 0 || constraints[index].count <= inner.count) {
+                    continue;
+                }
+                const Constraint &outer = constraints[index];
+                // Both cell lists are sorted, so the inner one is a subset if a merge finds all of it
+                int outside[8];
+                int outsideCount = 0;
+                int i = 0;
+                for (int j = 0; j < outer.count; j++) {
+                    if (i < inner.count && inner.cells[i] == outer.cells[j]) {
+                        i++;
+                    } else {
+                        outside[outsideCount++] = outer.cells[j];
+                    }
+                }
+                if (i < inner.count) {
+                    continue;
+                }
+                int mines = outer.mines - inner.mines;
+                if (mines != 0 && mines != outsideCount) {
+                    continue;
+                }
+                // Earlier deductions of this pass may have settled some of the cells already
+                for (int k = 0; k < outsideCount; k++) {
+                    int cellRow = outside[k] / width;
+                    int cellCol = outside[k] % width;
+                    if (board.at(cellRow, cellCol) != '#') {
+                        continue;
+                    }
+                    if (mines == 0) {
+                        board.reveal(minefield, cellRow, cellCol, scratch);
+                    } else {
+                        board.toggleFlag(cellRow, cellCol);
+                    }
+                    result.moves++;
+                    progress = true;
+                }
+            }
+        }
+    }
+    return progress;
+}
+
+/**
+ * @brief Picks the hidden cell least likely to hold a mine.
+ *
+ * A cell next to numbers gets the highest share of remaining mines among them; any other
+ * hidden cell gets the share of all remaining mines over all hidden cells. Ties are broken
+ * at random. Relies on the constraints left by applySubsetRules() for the same board.
+ *
+ * @param board The board shown to the player
+ * @param rng Breaks ties
+ * @return The index of the cell, or -1 if no cell is hidden
+ */
+int MinesweeperSolver::chooseGuess(const GameBoard &board, mt19937_64 &rng) {
+    const int width = board.width();
+    int hidden = 0;
+    for (size_t i = 0; i < board.size(); i++) {
+        hidden += board.data()[i] == '#';
+    }
+    if (hidden == 0) {
+        return -1;
+    }
+    const double density = static_cast<double>(board.remainingMines()) / hidden;
+
+    int best = -1;
+    double bestRisk = 2;
+    unsigned ties = 0;
+    for (int row = 0; row < board.height(); row++) {
+        for (int col = 0; col < width; col++) {
+            if (board.at(row, col) != '#') {
+                continue;
+            }
+            double risk = -1;
+            for (int r = max(row - 1, 0); r <= min(row + 1, board.height() - 1); r++) {
+                for (int c = max(col - 1, 0); c <= min(col + 1, width - 1); c++) {
+                    int index = constraintAt[r * width + c];
+                    if (index >= 0) {
+                        risk = max(risk, static_cast<double>(constraints[index].mines) / constraints[index].count);
+                    }
+                }
+            }
+            if (risk < 0) {
+                risk = density;
+            }
+            if (risk < bestRisk) {
+                bestRisk = risk;
+                best = row * width + col;
+                ties = 1;
+            } else if (risk == bestRisk && rng() % ++ties == 0) {
+                best = row * width + col;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Plays a game from its first click to the end.
+ *
+ * After the first click the single-cell rules run until they find nothing, then the
+ * subset rule; any move sends the solver back to the single-cell rules. Only when both
+ * are stuck does it guess, with chooseGuess(), or stop if guessing is off.
+ *
+ * @param minefield The minefield of the game
+ * @param board The board shown to the player, fully hidden at the start
+ * @param row The row of the first click
+ * @param col The column of the first click
+ * @param rng Breaks ties between equally good guesses
+ * @param guess False to stop with SolveOutcome::Stuck instead of guessing
+ * @return How the game ended, the number of moves and the number of guesses
+ */
+SolveResult MinesweeperSolver::play(const Board &minefield, GameBoard &board, int row, int col, mt19937_64 &rng,
+                                    bool guess) {
+    SolveResult result;
+    constraints.clear();
+    constraintAt.assign(board.size(), -1);
+    frontier.clear();
+    seen.assign(board.size(), '#');
+
+    board.reveal(minefield, row, col, scratch);
+    result.moves = 1;
+    if (minefield.at(row, col) == 'X') {
+        result.outcome = SolveOutcome::HitMine;
+        return result;
+    }
+
+    while (!board.cleared()) {
+        if (applySingleRules(minefield, board, result) || applySubsetRules(minefield, board, result)) {
+            continue;
+        }
+        int cell = guess ? chooseGuess(board, rng) : -1;
+        if (cell < 0) {
+            result.outcome = SolveOutcome::Stuck;
+            return result;
+        }
+        board.reveal(minefield, cell / board.width(), cell % board.width(), scratch);
+        result.guesses++;
+        result.moves++;
+        if (minefield.data()[cell] == 'X') {
+            result.outcome = SolveOutcome::HitMine;
+            return result;
+        }
+    }
+    result.outcome = SolveOutcome::Cleared;
+    return result;
+}
@@ -0,0 +1,87 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <random>
+#include <vector>
+#include "board.h"
+#include "floodfill.h"
+
+/**
+ * @brief How a game played by the solver ended.
+ */
+enum class SolveOutcome {
+    Cleared, /**< Every safe cell was revealed */
+    HitMine, /**< A guess revealed a mine */
+    Stuck /**< Guessing was not allowed and no cell could be deduced */
+};
+
+/**
+ * @struct SolveResult
+ * @brief The outcome of one game played by the solver.
+ */
+struct SolveResult {
+    SolveOutcome outcome = SolveOutcome::Stuck; /**< How the game ended */
+    int guesses = 0; /**< Cells revealed without being deduced safe, the first click excluded */
+    int moves = 0; /**< Reveals and flags made, the first click included */
+};
+
+/**
+ * @class MinesweeperSolver
+ * @brief Plays minesweeper without a player, seeing only what the player would see.
+ *
+ * The solver works on the board shown to the player and changes it through GameBoard::reveal()
+ * and GameBoard::toggleFlag(), the calls behind revealPos() and placeFlag(); the minefield
+ * is only consulted to learn whether a guess hit a mine. Each turn it tries, in order:
+ *
+ * 1. Single-cell rules: a number with as many flags around it as its value has only safe
+ *    hidden neighbours; one with as many hidden and flagged neighbours as its value has
+ *    only mines.
+ * 2. Subset rules: if the hidden neighbours of one number are a subset of those of
+ *    another, the cells only the second one sees hold the difference of their remaining
+ *    mines, which settles them when that difference is 0 or their count.
+ * 3. A guess: the hidden cell least likely to be a mine, judged by the numbers around it
+ *    or, for cells next to no number, by the density of the mines left.
+ *
+ * A solver keeps its buffers between games, so one per thread plays any number of them.
+ */
+class MinesweeperSolver {
+public:
+    /**
+     * @brief Plays a game from its first click to the end.
+     * @param minefield The minefield of the game
+     * @param board The board shown to the player, fully hidden at the start
+     * @param row The row of the first click
+     * @param col The column of the first click
+     * @param rng Breaks ties between equally good guesses
+     * @param guess False to stop with SolveOutcome::Stuck instead of guessing
+     * @return How the game ended and how many guesses it took
+     */
+    SolveResult play(const Board &minefield, GameBoard &board, int row, int col, std::mt19937_64 &rng,
+                     bool guess = true);
+
+private:
+    /**
+     * @struct Constraint
+     * @brief A revealed number and the hidden cells around it.
+     */
+    struct Constraint {
+        int cell; /**< The index of the number's own cell */
+        int cells[8]; /**< The hidden unflagged neighbours, in increasing index order */
+        int count; /**< The number of entries of cells */
+        int mines; /**< The mines among them: the number minus the flags around it */
+    };
+
+    bool constrain(const GameBoard &board, int row, int col, Constraint &constraint) const;
+    void collectNumbers(const GameBoard &board);
+    bool applySingleRules(const Board &minefield, GameBoard &board, SolveResult &result);
+    bool applySubsetRules(const Board &minefield, GameBoard &board, SolveResult &result);
+    int chooseGuess(const GameBoard &board, std::mt19937_64 &rng);
+
+    FloodScratch scratch; /**< Buffers of the flood fill of every reveal */
+    std::vector<Constraint> constraints; /**< The constraints of the current turn */
+    std::vector<int> constraintAt; /**< Index into constraints for each cell, -1 for none */
+    std::vector<int> frontier; /**< Revealed numbers that may still have hidden neighbours */
+    std::vector<char> seen; /**< The board as it was at the last collectNumbers() */
+};
+
+#endif